@@ -0,0 +1,62 @@
+/*
+ * Minimal libwindowmanager client: lists windows, optionally filtered by a
+ * keyword, and focuses the first match with --focus.
+ *
+ *   wm-example-list [keyword] [--focus]
+ */
+#include <stdio.h>
+#include <string.h>
+#include "windowmanager.h"
+
+int main(int argc, char* argv[]) {
+    const char* keyword = NULL;
+    int focus = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--focus") == 0) {
+            focus = 1;
+        } else {
+            keyword = argv[i];
+        }
+    }
+
+    if (wm_abi_version() != WM_ABI_VERSION) {
+        fprintf(stderr, "libwindowmanager ABI mismatch (library %u, header %u)\n", wm_abi_version(), WM_ABI_VERSION);
+        return 1;
+    }
+
+    wm_context* context = NULL;
+    wm_status status = wm_open(&context);
+    if (status != WM_OK) {
+        fprintf(stderr, "wm_open failed (status %d)\n", (int)status);
+        return 1;
+    }
+
+    wm_result* result = NULL;
+    status = keyword ? wm_search(context, keyword, 0, &result) : wm_snapshot(context, &result);
+    if (status != WM_OK) {
+        fprintf(stderr, "query failed: %s\n", wm_last_error(context));
+        wm_close(context);
+        return 1;
+    }
+
+    size_t count = wm_result_count(result);
+    for (size_t i = 0; i < count; ++i) {
+        wm_window window;
+        if (wm_result_get(result, i, &window) == WM_OK) {
+            printf("%-12s %-20s %s%s\n", window.handle, window.owner, window.title, window.focused ? " *" : "");
+        }
+    }
+    printf("%zu window(s), generation %llu\n", count, (unsigned long long)wm_result_generation(result));
+
+    if (focus && count > 0) {
+        wm_window first;
+        wm_result_get(result, 0, &first);
+        if (wm_focus(context, first.handle) != WM_OK) {
+            fprintf(stderr, "focus failed: %s\n", wm_last_error(context));
+        }
+    }
+
+    wm_result_free(result);
+    wm_close(context);
+    return 0;
+}
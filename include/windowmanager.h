@@ -0,0 +1,106 @@
+/*
+ * libwindowmanager - C ABI
+ *
+ * In-process access to window enumeration, search and focus without spawning
+ * the CLI or parsing JSON. All functions are safe to call from C.
+ *
+ * Ownership rules:
+ *   - wm_open() returns a context that must be released with wm_close().
+ *     A context may be used by one thread at a time.
+ *   - wm_snapshot() and wm_search() return immutable results that must be
+ *     released with wm_result_free(). Results stay valid after the context
+ *     refreshes and may be read from any thread.
+ *   - Strings in a wm_window point into the result and live until it is freed.
+ *
+ * ABI stability: existing functions and wm_window fields never change;
+ * additions bump WM_ABI_VERSION and only append fields to wm_window.
+ */
+#ifndef WINDOWMANAGER_H
+#define WINDOWMANAGER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define WM_ABI_VERSION 2
+
+#if defined(_WIN32) && defined(WM_SHARED_LIBRARY)
+    #ifdef WM_BUILDING_LIBRARY
+        #define WM_API __declspec(dllexport)
+    #else
+        #define WM_API __declspec(dllimport)
+    #endif
+#elif defined(__GNUC__)
+    #define WM_API __attribute__((visibility("default")))
+#else
+    #define WM_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct wm_context wm_context;
+typedef struct wm_result wm_result;
+
+typedef enum wm_status {
+    WM_OK = 0,
+    WM_ERROR_INVALID_ARGUMENT = 1,
+    WM_ERROR_NOT_FOUND = 2,           /* No such window handle */
+    WM_ERROR_PLATFORM = 3,            /* Unsupported platform or display unavailable */
+    WM_ERROR_PERMISSION = 4,          /* Accessibility / display permissions missing */
+    WM_ERROR_FAILED = 5               /* Operation failed; see wm_last_error() */
+} wm_status;
+
+/* wm_search() flags */
+#define WM_SEARCH_CASE_SENSITIVE 0x1u
+#define WM_SEARCH_REGEX          0x2u
+#define WM_SEARCH_TITLE_ONLY     0x4u
+#define WM_SEARCH_OWNER_ONLY     0x8u
+
+typedef struct wm_window {
+    const char* handle;
+    const char* title;
+    const char* owner;
+    const char* workspace_id;
+    int32_t x;
+    int32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t process_id;
+    int visible;
+    int focused;
+    int on_current_workspace;
+    int minimized;
+} wm_window;
+
+/* Version of the library actually loaded (compare with WM_ABI_VERSION) */
+WM_API unsigned int wm_abi_version(void);
+
+/* Context */
+WM_API wm_status wm_open(wm_context** out_context);
+WM_API void wm_close(wm_context* context);
+WM_API const char* wm_last_error(const wm_context* context); /* Never NULL; empty when no error */
+
+/* Window lists; wm_snapshot() reuses the cached list while it is fresh */
+WM_API wm_status wm_refresh(wm_context* context);
+/* Stale-while-revalidate (ABI 2): serve expired data up to max_staleness_ms old while
+   refreshing in the background; wm_refresh() still forces fresh data */
+WM_API wm_status wm_set_stale_while_revalidate(wm_context* context, int enabled, uint32_t max_staleness_ms);
+WM_API wm_status wm_snapshot(wm_context* context, wm_result** out_result);
+WM_API wm_status wm_search(wm_context* context, const char* query, unsigned int flags, wm_result** out_result);
+
+/* Result iteration */
+WM_API size_t wm_result_count(const wm_result* result);
+WM_API uint64_t wm_result_generation(const wm_result* result); /* Increases with every refresh */
+WM_API uint64_t wm_result_age_ms(const wm_result* result);     /* Age of the snapshot (ABI 2) */
+WM_API wm_status wm_result_get(const wm_result* result, size_t index, wm_window* out_window);
+WM_API void wm_result_free(wm_result* result);
+
+/* Focus (switches workspace when needed) */
+WM_API wm_status wm_focus(wm_context* context, const char* handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WINDOWMANAGER_H */
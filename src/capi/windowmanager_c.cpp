@@ -0,0 +1,229 @@
+#include "windowmanager_c_internal.hpp"
+#include "../core/exceptions.hpp"
+#include "../filters/search_query.hpp"
+#include <string>
+#include <vector>
+
+struct wm_context {
+    std::unique_ptr<WindowManager::WindowManager> windowManager;
+    std::string lastError;
+};
+
+struct wm_result {
+    // Shares the immutable snapshot instead of copying windows
+    std::shared_ptr<const WindowManager::WindowSnapshot> snapshot;
+    std::vector<const WindowManager::WindowInfo*> windows;
+};
+
+namespace {
+
+// Translates the exception hierarchy into status codes at the ABI boundary
+template <typename Operation>
+wm_status guarded(wm_context* context, Operation&& operation) {
+    context->lastError.clear();
+    try {
+        return operation();
+    } catch (const WindowManager::PlatformNotSupportedException& e) {
+        context->lastError = e.what();
+        return WM_ERROR_PLATFORM;
+    } catch (const WindowManager::PermissionDeniedException& e) {
+        context->lastError = e.what();
+        return WM_ERROR_PERMISSION;
+    } catch (const WindowManager::InvalidHandleException& e) {
+        context->lastError = e.what();
+        return WM_ERROR_NOT_FOUND;
+    } catch (const std::exception& e) {
+        context->lastError = e.what();
+        return WM_ERROR_FAILED;
+    } catch (...) {
+        context->lastError = "unknown error";
+        return WM_ERROR_FAILED;
+    }
+}
+
+wm_status failWith(wm_context* context, wm_status status, const char* message) {
+    context->lastError = message;
+    return status;
+}
+
+} // namespace
+
+namespace WindowManager {
+
+wm_context* createCApiContext(std::unique_ptr<WindowManager> windowManager) {
+    auto* context = new wm_context();
+    context->windowManager = std::move(windowManager);
+    return context;
+}
+
+} // namespace WindowManager
+
+extern "C" {
+
+unsigned int wm_abi_version(void) {
+    return WM_ABI_VERSION;
+}
+
+wm_status wm_open(wm_context** out_context) {
+    if (!out_context) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+    *out_context = nullptr;
+
+    try {
+        *out_context = WindowManager::createCApiContext(WindowManager::WindowManager::create());
+        return WM_OK;
+    } catch (const WindowManager::PlatformNotSupportedException&) {
+        return WM_ERROR_PLATFORM;
+    } catch (const WindowManager::PermissionDeniedException&) {
+        return WM_ERROR_PERMISSION;
+    } catch (...) {
+        return WM_ERROR_PLATFORM; // Typically no display to connect to
+    }
+}
+
+void wm_close(wm_context* context) {
+    delete context;
+}
+
+const char* wm_last_error(const wm_context* context) {
+    return context ? context->lastError.c_str() : "";
+}
+
+wm_status wm_refresh(wm_context* context) {
+    if (!context) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+    return guarded(context, [&]() {
+        return context->windowManager->refreshWindows() ? WM_OK
+                                                        : failWith(context, WM_ERROR_FAILED, "window enumeration failed");
+    });
+}
+
+wm_status wm_set_stale_while_revalidate(wm_context* context, int enabled, uint32_t max_staleness_ms) {
+    if (!context) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+    context->windowManager->setStaleWhileRevalidate(enabled != 0, std::chrono::milliseconds(max_staleness_ms));
+    return WM_OK;
+}
+
+wm_status wm_snapshot(wm_context* context, wm_result** out_result) {
+    if (!context || !out_result) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+    *out_result = nullptr;
+
+    return guarded(context, [&]() {
+        auto result = std::make_unique<wm_result>();
+        result->snapshot = context->windowManager->getSnapshot();
+        if (!result->snapshot) {
+            return failWith(context, WM_ERROR_FAILED, "window enumeration failed");
+        }
+        result->windows.reserve(result->snapshot->windows.size());
+        for (const auto& window : result->snapshot->windows) {
+            result->windows.push_back(&window);
+        }
+        *out_result = result.release();
+        return WM_OK;
+    });
+}
+
+wm_status wm_search(wm_context* context, const char* query, unsigned int flags, wm_result** out_result) {
+    if (!context || !query || !out_result) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+    *out_result = nullptr;
+
+    return guarded(context, [&]() {
+        WindowManager::SearchField field = WindowManager::SearchField::Both;
+        if (flags & WM_SEARCH_TITLE_ONLY) {
+            field = WindowManager::SearchField::Title;
+        } else if (flags & WM_SEARCH_OWNER_ONLY) {
+            field = WindowManager::SearchField::Owner;
+        }
+        WindowManager::SearchQuery searchQuery(query, field, (flags & WM_SEARCH_CASE_SENSITIVE) != 0,
+                                               (flags & WM_SEARCH_REGEX) != 0);
+        if (!searchQuery.isValid()) {
+            return failWith(context, WM_ERROR_INVALID_ARGUMENT, "invalid search query");
+        }
+
+        auto result = std::make_unique<wm_result>();
+        result->snapshot = context->windowManager->getSnapshot();
+        if (!result->snapshot) {
+            return failWith(context, WM_ERROR_FAILED, "window enumeration failed");
+        }
+        for (const auto& window : result->snapshot->windows) {
+            if (searchQuery.matches(window)) {
+                result->windows.push_back(&window);
+            }
+        }
+        *out_result = result.release();
+        return WM_OK;
+    });
+}
+
+size_t wm_result_count(const wm_result* result) {
+    return result ? result->windows.size() : 0;
+}
+
+uint64_t wm_result_generation(const wm_result* result) {
+    return result && result->snapshot ? result->snapshot->generation : 0;
+}
+
+uint64_t wm_result_age_ms(const wm_result* result) {
+    return result && result->snapshot ? static_cast<uint64_t>(result->snapshot->age().count()) : 0;
+}
+
+wm_status wm_result_get(const wm_result* result, size_t index, wm_window* out_window) {
+    if (!result || !out_window || index >= result->windows.size()) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+
+    const WindowManager::WindowInfo& window = *result->windows[index];
+    out_window->handle = window.handle.c_str();
+    out_window->title = window.title.c_str();
+    out_window->owner = window.ownerName.c_str();
+    out_window->workspace_id = window.workspaceId.c_str();
+    out_window->x = window.x;
+    out_window->y = window.y;
+    out_window->width = window.width;
+    out_window->height = window.height;
+    out_window->process_id = window.processId;
+    out_window->visible = window.isVisible ? 1 : 0;
+    out_window->focused = window.isFocused ? 1 : 0;
+    out_window->on_current_workspace = window.isOnCurrentWorkspace ? 1 : 0;
+    out_window->minimized = window.isMinimized ? 1 : 0;
+    return WM_OK;
+}
+
+void wm_result_free(wm_result* result) {
+    delete result;
+}
+
+wm_status wm_focus(wm_context* context, const char* handle) {
+    if (!context || !handle || !*handle) {
+        return WM_ERROR_INVALID_ARGUMENT;
+    }
+
+    return guarded(context, [&]() {
+        auto& windowManager = *context->windowManager;
+
+        // Known handle: focus straight from the snapshot without re-validating it
+        auto snapshot = windowManager.getLatestSnapshot();
+        const WindowManager::WindowInfo* window = snapshot ? snapshot->findWindow(handle) : nullptr;
+        if (window) {
+            return windowManager.focusWindowFromSnapshot(*window)
+                       ? WM_OK
+                       : failWith(context, WM_ERROR_FAILED, "focus operation failed");
+        }
+
+        if (!windowManager.validateHandle(handle)) {
+            return failWith(context, WM_ERROR_NOT_FOUND, "no window with this handle");
+        }
+        return windowManager.focusWindowByHandle(handle) ? WM_OK
+                                                         : failWith(context, WM_ERROR_FAILED, "focus operation failed");
+    });
+}
+
+} // extern "C"
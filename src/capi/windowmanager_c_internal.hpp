@@ -0,0 +1,13 @@
+#pragma once
+
+#include "windowmanager.h"
+#include "../core/window_manager.hpp"
+#include <memory>
+
+namespace WindowManager {
+
+// Wraps an existing manager (e.g. with a custom enumerator) in a C API context;
+// release it with wm_close()
+wm_context* createCApiContext(std::unique_ptr<WindowManager> windowManager);
+
+} // namespace WindowManager
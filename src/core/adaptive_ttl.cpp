@@ -0,0 +1,48 @@
+#include "adaptive_ttl.hpp"
+#include <algorithm>
+
+namespace WindowManager {
+
+AdaptiveTtl::AdaptiveTtl(std::chrono::milliseconds minimum, std::chrono::milliseconds maximum,
+                         std::chrono::milliseconds initial)
+    : minimumMs_(minimum.count())
+    , maximumMs_(std::max(minimum, maximum).count())
+    , currentMs_(0) {
+    currentMs_ = clamp(initial.count());
+}
+
+void AdaptiveTtl::recordRefresh(bool changed) {
+    double factor = changed ? SHRINK_FACTOR : GROWTH_FACTOR;
+    currentMs_ = clamp(static_cast<long long>(static_cast<double>(currentMs_.load()) * factor));
+
+    double sample = changed ? 1.0 : 0.0;
+    changeRate_ = changeRate_.load() * (1.0 - CHANGE_RATE_SMOOTHING) + sample * CHANGE_RATE_SMOOTHING;
+}
+
+std::chrono::milliseconds AdaptiveTtl::current() const {
+    return std::chrono::milliseconds(currentMs_.load());
+}
+
+void AdaptiveTtl::setBounds(std::chrono::milliseconds minimum, std::chrono::milliseconds maximum) {
+    minimumMs_ = minimum.count();
+    maximumMs_ = std::max(minimum, maximum).count();
+    currentMs_ = clamp(currentMs_.load());
+}
+
+std::chrono::milliseconds AdaptiveTtl::getMinimum() const {
+    return std::chrono::milliseconds(minimumMs_.load());
+}
+
+std::chrono::milliseconds AdaptiveTtl::getMaximum() const {
+    return std::chrono::milliseconds(maximumMs_.load());
+}
+
+double AdaptiveTtl::getChangeRate() const {
+    return changeRate_.load();
+}
+
+long long AdaptiveTtl::clamp(long long milliseconds) const {
+    return std::min(std::max(milliseconds, minimumMs_.load()), maximumMs_.load());
+}
+
+} // namespace WindowManager
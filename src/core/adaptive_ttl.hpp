@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace WindowManager {
+
+/**
+ * Cache time-to-live that follows the observed change rate
+ * Every refresh reports whether the data actually differed from the previous
+ * snapshot: a change shrinks the TTL (multiplicative decrease), an unchanged
+ * refresh grows it, always within [minimum, maximum]. Busy desktops get fresh
+ * data quickly, idle ones stop being re-enumerated.
+ *
+ * recordRefresh() must be called by one thread at a time; current() is lock-free.
+ */
+class AdaptiveTtl {
+public:
+    static constexpr double SHRINK_FACTOR = 0.5;
+    static constexpr double GROWTH_FACTOR = 1.5;
+
+    AdaptiveTtl(std::chrono::milliseconds minimum, std::chrono::milliseconds maximum,
+                std::chrono::milliseconds initial);
+
+    void recordRefresh(bool changed);
+    std::chrono::milliseconds current() const;
+
+    void setBounds(std::chrono::milliseconds minimum, std::chrono::milliseconds maximum);
+    std::chrono::milliseconds getMinimum() const;
+    std::chrono::milliseconds getMaximum() const;
+
+    // Fraction of recent refreshes that observed a change (exponential moving average)
+    double getChangeRate() const;
+
+private:
+    std::atomic<long long> minimumMs_;
+    std::atomic<long long> maximumMs_;
+    std::atomic<long long> currentMs_;
+    std::atomic<double> changeRate_{0.0};
+
+    static constexpr double CHANGE_RATE_SMOOTHING = 0.2;
+
+    long long clamp(long long milliseconds) const;
+};
+
+} // namespace WindowManager
@@ -0,0 +1,82 @@
+#include "change_coalescer.hpp"
+#include <algorithm>
+
+namespace WindowManager {
+
+ChangeCoalescer::ChangeCoalescer(std::chrono::milliseconds latency)
+    : latency_(std::max(latency, std::chrono::milliseconds(0))) {
+}
+
+bool ChangeCoalescer::submit(uint64_t key, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.received;
+
+    if (latency_.count() > 0) {
+        auto it = slots_.find(key);
+        if (it != slots_.end() && now < it->second.windowEnd) {
+            it->second.held = true;
+            return false;
+        }
+        slots_[key] = Slot{now + latency_, false};
+    }
+
+    ++stats_.delivered;
+    return true;
+}
+
+std::vector<uint64_t> ChangeCoalescer::takeDue(Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<uint64_t> due;
+    for (auto& [key, slot] : slots_) {
+        if (slot.held && now >= slot.windowEnd) {
+            // Trailing edge; a burst that keeps going stays throttled
+            slot.held = false;
+            slot.windowEnd = now + latency_;
+            due.push_back(key);
+        }
+    }
+    stats_.delivered += due.size();
+
+    expireIdleSlots(now);
+    return due;
+}
+
+std::optional<ChangeCoalescer::Clock::time_point> ChangeCoalescer::nextDeadline() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::optional<Clock::time_point> deadline;
+    for (const auto& [key, slot] : slots_) {
+        if (slot.held && (!deadline || slot.windowEnd < *deadline)) {
+            deadline = slot.windowEnd;
+        }
+    }
+    return deadline;
+}
+
+void ChangeCoalescer::setLatency(std::chrono::milliseconds latency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_ = std::max(latency, std::chrono::milliseconds(0));
+}
+
+std::chrono::milliseconds ChangeCoalescer::getLatency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latency_;
+}
+
+ChangeCoalescingStats ChangeCoalescer::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void ChangeCoalescer::expireIdleSlots(Clock::time_point now) {
+    for (auto it = slots_.begin(); it != slots_.end();) {
+        if (!it->second.held && now >= it->second.windowEnd) {
+            it = slots_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace WindowManager
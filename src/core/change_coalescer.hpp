@@ -0,0 +1,67 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Change counters reported by a ChangeCoalescer
+ */
+struct ChangeCoalescingStats {
+    uint64_t received = 0;  // Changes submitted
+    uint64_t delivered = 0; // Updates actually let through
+
+    // Share of changes folded into another update (0 = nothing coalesced)
+    double ratio() const {
+        return received == 0 ? 0.0 : 1.0 - static_cast<double>(delivered) / static_cast<double>(received);
+    }
+};
+
+/**
+ * Per-key leading/trailing-edge throttle for bursty change notifications
+ * The first change of a key after a quiet period is delivered at once and opens a
+ * window of `latency`; further changes inside it are held and delivered as one
+ * update when the window closes, so the final value is never lost. Keys are
+ * independent: one window spamming title updates does not delay the others.
+ *
+ * Thread-safe.
+ */
+class ChangeCoalescer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::milliseconds DEFAULT_LATENCY{250};
+
+    explicit ChangeCoalescer(std::chrono::milliseconds latency = DEFAULT_LATENCY);
+
+    // Returns true when the change should be delivered now; false when it was held
+    bool submit(uint64_t key, Clock::time_point now = Clock::now());
+
+    // Keys whose held change is due; each opens a new window
+    std::vector<uint64_t> takeDue(Clock::time_point now = Clock::now());
+    std::optional<Clock::time_point> nextDeadline() const;
+
+    void setLatency(std::chrono::milliseconds latency); // 0 disables coalescing
+    std::chrono::milliseconds getLatency() const;
+    ChangeCoalescingStats getStats() const;
+
+private:
+    struct Slot {
+        Clock::time_point windowEnd;
+        bool held = false;
+    };
+
+    mutable std::mutex mutex_;
+    std::chrono::milliseconds latency_;
+    std::unordered_map<uint64_t, Slot> slots_;
+    ChangeCoalescingStats stats_;
+
+    void expireIdleSlots(Clock::time_point now); // Caller holds mutex_
+};
+
+} // namespace WindowManager
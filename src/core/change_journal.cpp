@@ -0,0 +1,186 @@
+#include "change_journal.hpp"
+#include <unordered_map>
+
+namespace WindowManager {
+
+uint32_t diffWindowFields(const WindowInfo& before, const WindowInfo& after) {
+    uint32_t fields = 0;
+    if (before.title != after.title) {
+        fields |= WindowFieldTitle;
+    }
+    if (before.x != after.x || before.y != after.y ||
+        before.width != after.width || before.height != after.height) {
+        fields |= WindowFieldGeometry;
+    }
+    if (before.isVisible != after.isVisible) {
+        fields |= WindowFieldVisibility;
+    }
+    if (before.processId != after.processId || before.ownerName != after.ownerName) {
+        fields |= WindowFieldProcess;
+    }
+    if (before.workspaceId != after.workspaceId || before.workspaceName != after.workspaceName ||
+        before.isOnCurrentWorkspace != after.isOnCurrentWorkspace) {
+        fields |= WindowFieldWorkspace;
+    }
+    if (before.state != after.state || before.isFocused != after.isFocused ||
+        before.isMinimized != after.isMinimized) {
+        fields |= WindowFieldState;
+    }
+    return fields;
+}
+
+std::vector<std::string> windowFieldNames(uint32_t fields) {
+    static const std::pair<WindowField, const char*> names[] = {
+        {WindowFieldTitle, "title"},
+        {WindowFieldGeometry, "geometry"},
+        {WindowFieldVisibility, "visibility"},
+        {WindowFieldProcess, "process"},
+        {WindowFieldWorkspace, "workspace"},
+        {WindowFieldState, "state"},
+    };
+
+    std::vector<std::string> result;
+    for (const auto& [field, name] : names) {
+        if (fields & field) {
+            result.emplace_back(name);
+        }
+    }
+    return result;
+}
+
+ChangeJournal::ChangeJournal(size_t capacity)
+    : capacity_(capacity == 0 ? 1 : capacity) {
+}
+
+bool ChangeJournal::record(uint64_t generation, const std::vector<WindowInfo>& previous,
+                           const std::vector<WindowInfo>& current) {
+    Entry entry{generation, {}};
+
+    std::unordered_map<std::string, const WindowInfo*> before;
+    before.reserve(previous.size());
+    for (const auto& window : previous) {
+        before.emplace(window.handle, &window);
+    }
+
+    for (const auto& window : current) {
+        auto it = before.find(window.handle);
+        if (it == before.end()) {
+            entry.records.push_back({window.handle, ChangeKind::Added, WindowFieldAll});
+            continue;
+        }
+        uint32_t fields = diffWindowFields(*it->second, window);
+        if (fields != 0) {
+            entry.records.push_back({window.handle, ChangeKind::Modified, fields});
+        }
+        before.erase(it);
+    }
+    for (const auto& window : previous) {
+        if (before.count(window.handle)) {
+            entry.records.push_back({window.handle, ChangeKind::Removed, WindowFieldAll});
+        }
+    }
+
+    bool changed = !entry.records.empty();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A gap in the generations (e.g. a failed refresh) breaks the chain
+    if (!entries_.empty() && entries_.back().generation + 1 != generation) {
+        entries_.clear();
+    }
+    entries_.push_back(std::move(entry));
+    while (entries_.size() > capacity_) {
+        entries_.pop_front();
+    }
+    return changed;
+}
+
+WindowDelta ChangeJournal::changesSince(uint64_t generation, const WindowSnapshot& target) const {
+    if (generation == target.generation) {
+        WindowDelta delta;
+        delta.fromGeneration = delta.toGeneration = generation;
+        return delta;
+    }
+
+    struct Accumulated {
+        bool existedBefore;
+        uint32_t fields;
+    };
+    std::vector<std::string> order; // First appearance, for a stable output order
+    std::unordered_map<std::string, Accumulated> touched;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (generation == 0 || generation > target.generation || entries_.empty() ||
+            generation + 1 < entries_.front().generation || entries_.back().generation < target.generation) {
+            return fullDelta(generation, target);
+        }
+
+        for (const auto& entry : entries_) {
+            if (entry.generation <= generation) {
+                continue;
+            }
+            if (entry.generation > target.generation) {
+                break;
+            }
+            for (const auto& record : entry.records) {
+                auto [it, inserted] = touched.try_emplace(record.handle,
+                                                          Accumulated{record.kind != ChangeKind::Added, 0});
+                if (inserted) {
+                    order.push_back(record.handle);
+                }
+                it->second.fields |= record.fields;
+            }
+        }
+    }
+
+    std::unordered_map<std::string, const WindowInfo*> now;
+    now.reserve(target.windows.size());
+    for (const auto& window : target.windows) {
+        now.emplace(window.handle, &window);
+    }
+
+    WindowDelta delta;
+    delta.fromGeneration = generation;
+    delta.toGeneration = target.generation;
+    for (const auto& handle : order) {
+        const auto& change = touched[handle];
+        auto it = now.find(handle);
+        bool existsNow = it != now.end();
+
+        if (!change.existedBefore && existsNow) {
+            delta.added.push_back(*it->second);
+        } else if (change.existedBefore && !existsNow) {
+            delta.removed.push_back(handle);
+        } else if (change.existedBefore && existsNow) {
+            delta.modified.push_back({*it->second, change.fields});
+        }
+        // Added and removed again within the range: nothing to report
+    }
+    return delta;
+}
+
+void ChangeJournal::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t ChangeJournal::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t ChangeJournal::oldestGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.empty() ? 0 : entries_.front().generation - 1;
+}
+
+WindowDelta ChangeJournal::fullDelta(uint64_t generation, const WindowSnapshot& target) {
+    WindowDelta delta;
+    delta.fromGeneration = generation;
+    delta.toGeneration = target.generation;
+    delta.fullSnapshot = true;
+    delta.added = target.windows;
+    return delta;
+}
+
+} // namespace WindowManager
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "window.hpp"
+#include "window_snapshot.hpp"
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Window fields reported in WindowChange::changedFields (bit mask)
+ */
+enum WindowField : uint32_t {
+    WindowFieldTitle      = 1u << 0,
+    WindowFieldGeometry   = 1u << 1, // x, y, width, height
+    WindowFieldVisibility = 1u << 2,
+    WindowFieldProcess    = 1u << 3, // processId, ownerName
+    WindowFieldWorkspace  = 1u << 4, // workspaceId, workspaceName, isOnCurrentWorkspace
+    WindowFieldState      = 1u << 5, // state, isFocused, isMinimized
+    WindowFieldAll        = (1u << 6) - 1
+};
+
+uint32_t diffWindowFields(const WindowInfo& before, const WindowInfo& after);
+std::vector<std::string> windowFieldNames(uint32_t fields);
+
+struct WindowChange {
+    WindowInfo window;          // State at WindowDelta::toGeneration
+    uint32_t changedFields = 0; // WindowField mask
+};
+
+/**
+ * Difference between two snapshot generations
+ * When the journal no longer covers fromGeneration, fullSnapshot is set and
+ * `added` holds every window: the consumer replaces its copy instead of patching it.
+ */
+struct WindowDelta {
+    uint64_t fromGeneration = 0;
+    uint64_t toGeneration = 0;
+    bool fullSnapshot = false;
+    std::vector<WindowInfo> added;
+    std::vector<std::string> removed;
+    std::vector<WindowChange> modified;
+
+    bool empty() const { return added.empty() && removed.empty() && modified.empty(); }
+};
+
+/**
+ * Bounded journal of per-generation window changes
+ * Each refresh records which handles were added, removed or modified (with field
+ * masks); the window contents themselves come from the target snapshot, so an
+ * entry costs a handle and a mask per change. The oldest generations are dropped
+ * once the capacity is exceeded.
+ *
+ * Thread-safe.
+ */
+class ChangeJournal {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256; // Generations retained
+
+    explicit ChangeJournal(size_t capacity = DEFAULT_CAPACITY);
+
+    // Records the transition to `generation`; returns false when nothing changed
+    bool record(uint64_t generation, const std::vector<WindowInfo>& previous,
+                const std::vector<WindowInfo>& current);
+
+    // Changes from `generation` up to target.generation; generation 0 or one the
+    // journal no longer (or never) covered yields a full snapshot
+    WindowDelta changesSince(uint64_t generation, const WindowSnapshot& target) const;
+
+    void clear();
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    uint64_t oldestGeneration() const; // Oldest generation a delta can start from; 0 when empty
+
+private:
+    enum class ChangeKind { Added, Removed, Modified };
+
+    struct Record {
+        std::string handle;
+        ChangeKind kind;
+        uint32_t fields;
+    };
+
+    struct Entry {
+        uint64_t generation;
+        std::vector<Record> records;
+    };
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::deque<Entry> entries_; // Consecutive generations, oldest first
+
+    static WindowDelta fullDelta(uint64_t generation, const WindowSnapshot& target);
+};
+
+} // namespace WindowManager
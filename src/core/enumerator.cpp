@@ -9,6 +9,7 @@
     #include "../platform/macos/cocoa_enumerator.hpp"
 #elif defined(WM_PLATFORM_LINUX)
     #include "../platform/linux/x11_enumerator.hpp"
+    #include "../platform/linux/multi_display_enumerator.hpp"
 #endif
 
 namespace WindowManager {
@@ -26,6 +27,69 @@ std::unique_ptr<WindowEnumerator> WindowEnumerator::create() {
 #endif
 }
 
+std::unique_ptr<WindowEnumerator> WindowEnumerator::create(const std::vector<std::string>& displayNames) {
+    if (displayNames.empty()) {
+        return create();
+    }
+#ifdef WM_PLATFORM_LINUX
+    if (displayNames.size() == 1) {
+        return std::make_unique<X11Enumerator>(displayNames.front());
+    }
+    return std::make_unique<MultiDisplayEnumerator>(displayNames);
+#else
+    throw ConfigurationException("displays", std::string("display selection is not supported on ") + WM_PLATFORM_NAME);
+#endif
+}
+
+// Default change notification support: none, callers poll on a timer
+bool WindowEnumerator::supportsChangeNotifications() const {
+    return false;
+}
+
+bool WindowEnumerator::waitForChanges(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    if (waitCondition_.wait_for(lock, timeout, [this]() { return waitInterrupted_; })) {
+        waitInterrupted_ = false;
+        return false; // Interrupted: nothing is known to have changed
+    }
+    return true;
+}
+
+void WindowEnumerator::interruptWaitForChanges() {
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        waitInterrupted_ = true;
+    }
+    waitCondition_.notify_all();
+}
+
+int WindowEnumerator::getChangeNotificationFd() const {
+    return -1;
+}
+
+bool WindowEnumerator::processChangeNotifications() {
+    return false;
+}
+
+void WindowEnumerator::setChangeCoalescingLatency(std::chrono::milliseconds) {
+}
+
+std::optional<std::chrono::steady_clock::time_point> WindowEnumerator::getNextChangeDeadline() const {
+    return std::nullopt;
+}
+
+ChangeCoalescingStats WindowEnumerator::getChangeCoalescingStats() const {
+    return {};
+}
+
+std::optional<WindowThumbnail> WindowEnumerator::captureThumbnail(const std::string&, unsigned int, unsigned int) {
+    return std::nullopt;
+}
+
+uint64_t WindowEnumerator::getServerRequestCount() const {
+    return 0;
+}
+
 // Helper method for updating timing information
 void WindowEnumerator::updateEnumerationTime(const std::chrono::steady_clock::time_point& start,
                                             const std::chrono::steady_clock::time_point& end) {
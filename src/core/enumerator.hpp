@@ -2,10 +2,15 @@
 
 #include "window.hpp"
 #include "workspace.hpp"
+#include "thumbnail.hpp"
+#include "change_coalescer.hpp"
 #include <vector>
 #include <memory>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <optional>
+#include <cstdint>
 
 namespace WindowManager {
 
@@ -39,13 +44,44 @@ public:
     virtual bool switchToWorkspace(const std::string& workspaceId) = 0;
     virtual bool canSwitchWorkspaces() const = 0;
 
+    // Change notifications for event-driven refresh
+    // Platforms without notifications fall back to polling: waitForChanges() sleeps for
+    // the timeout and reports a (possible) change
+    virtual bool supportsChangeNotifications() const;
+    virtual bool waitForChanges(std::chrono::milliseconds timeout);
+
+    // Ends a blocked waitForChanges() early; callable from any thread. An interrupt that
+    // arrives before the wait starts ends the next wait immediately.
+    virtual void interruptWaitForChanges();
+
+    // Same notifications for callers running their own event loop: poll the fd for
+    // readability, then processChangeNotifications() drains without blocking
+    virtual int getChangeNotificationFd() const;   // -1 when unsupported
+    virtual bool processChangeNotifications();
+
+    // Bursts of title changes from one window are coalesced into one update per latency
+    // window. Held changes are reported once their window closes: event-loop callers
+    // must call processChangeNotifications() again at getNextChangeDeadline().
+    virtual void setChangeCoalescingLatency(std::chrono::milliseconds latency);
+    virtual std::optional<std::chrono::steady_clock::time_point> getNextChangeDeadline() const;
+    virtual ChangeCoalescingStats getChangeCoalescingStats() const;
+
+    // Window content capture for previews, downsampled to fit maxWidth x maxHeight pixels
+    // Returns nullopt where capturing is unsupported or the window is not viewable
+    virtual std::optional<WindowThumbnail> captureThumbnail(const std::string& handle,
+                                                            unsigned int maxWidth, unsigned int maxHeight);
+
     // Performance and diagnostics
     virtual std::chrono::milliseconds getLastEnumerationTime() const = 0;
     virtual size_t getWindowCount() const = 0;
     virtual std::string getPlatformInfo() const = 0;
+    virtual uint64_t getServerRequestCount() const; // Requests sent to the display server so far (0 = not tracked)
 
     // Factory method - implemented in enumerator.cpp
     static std::unique_ptr<WindowEnumerator> create();
+    // Named X displays (":0", "host:1.0"); several are enumerated in parallel with
+    // display-qualified handles. Empty = the default display.
+    static std::unique_ptr<WindowEnumerator> create(const std::vector<std::string>& displayNames);
 
 protected:
     // Protected members for derived classes
@@ -59,6 +95,12 @@ protected:
     // Helper method for updating timing information
     void updateEnumerationTime(const std::chrono::steady_clock::time_point& start,
                               const std::chrono::steady_clock::time_point& end);
+
+private:
+    // Polling fallback of waitForChanges()
+    std::mutex waitMutex_;
+    std::condition_variable waitCondition_;
+    bool waitInterrupted_ = false;
 };
 
 } // namespace WindowManager
\ No newline at end of file
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Downsampled capture of a window's contents
+ * Pixels are packed 0xRRGGBB, row-major, width * height entries
+ */
+struct WindowThumbnail {
+    std::string handle;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    std::vector<uint32_t> pixels;
+    std::chrono::steady_clock::time_point capturedAt;
+
+    uint32_t pixelAt(unsigned int x, unsigned int y) const {
+        return pixels[static_cast<size_t>(y) * width + x];
+    }
+};
+
+} // namespace WindowManager
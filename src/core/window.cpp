@@ -22,6 +22,7 @@ WindowInfo::WindowInfo()
     , state(WindowState::Normal)
     , isFocused(false)
     , isMinimized(false)
+    , contentVersion(0)
 {
 }
 
@@ -44,6 +45,7 @@ WindowInfo::WindowInfo(const std::string& handle, const std::string& title,
     , state(WindowState::Normal)
     , isFocused(false)
     , isMinimized(false)
+    , contentVersion(0)
 {
 }
 
@@ -68,6 +70,7 @@ WindowInfo::WindowInfo(const std::string& handle, const std::string& title,
     , state(state)
     , isFocused(state == WindowState::Focused)
     , isMinimized(state == WindowState::Minimized)
+    , contentVersion(0)
 {
 }
 
@@ -139,6 +142,9 @@ std::string WindowInfo::toJson() const {
     std::ostringstream oss;
     oss << "{\n";
     oss << "  \"handle\": \"" << handle << "\",\n";
+    if (!display.empty()) {
+        oss << "  \"display\": \"" << display << "\",\n";
+    }
     oss << "  \"title\": \"" << title << "\",\n";
     oss << "  \"x\": " << x << ", \"y\": " << y << ",\n";
     oss << "  \"width\": " << width << ", \"height\": " << height << ",\n";
@@ -295,6 +301,41 @@ std::string WindowInfo::getWorkspaceJsonFragment() const {
 }
 
 // Comparison operators
+uint64_t WindowInfo::computeContentVersion() const {
+    // FNV-1a over the same fields operator== compares
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+    };
+    auto mixString = [&mix](const std::string& text) {
+        size_t length = text.size();
+        mix(&length, sizeof(length));
+        mix(text.data(), length);
+    };
+    auto mixValue = [&mix](auto value) { mix(&value, sizeof(value)); };
+
+    mixString(handle);
+    mixString(title);
+    mixValue(x);
+    mixValue(y);
+    mixValue(width);
+    mixValue(height);
+    mixValue(isVisible);
+    mixValue(processId);
+    mixString(ownerName);
+    mixString(workspaceId);
+    mixString(workspaceName);
+    mixValue(isOnCurrentWorkspace);
+    mixValue(state);
+    mixValue(isFocused);
+    mixValue(isMinimized);
+
+    return hash == 0 ? 1 : hash;
+}
+
 bool WindowInfo::operator==(const WindowInfo& other) const {
     return handle == other.handle &&
            title == other.title &&
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <chrono>
+#include <cstdint>
 #include <vector>
 
 namespace WindowManager {
@@ -27,6 +28,7 @@ enum class WindowState {
 struct WindowInfo {
     // Universal window identifier (platform-specific type erased to string)
     std::string handle;
+    std::string display; // Display server the window lives on; set by multi-display enumeration only
 
     // Window display properties
     std::string title;
@@ -54,6 +56,10 @@ struct WindowInfo {
     bool requiresRestore;                 // Whether window needs restoration before focus
     bool workspaceSwitchRequired;         // Whether focusing requires workspace change
 
+    // Hash of the fields compared by operator==; stamped when a snapshot is published
+    // (0 = not computed yet). Serves as the window's ETag.
+    uint64_t contentVersion;
+
     // Default constructor
     WindowInfo();
 
@@ -88,6 +94,7 @@ struct WindowInfo {
     bool canBeFocused() const;            // NEW: Whether window is focusable
     bool needsWorkspaceSwitch() const;    // NEW: Whether workspace switching is required
     bool needsRestoration() const;        // NEW: Whether window needs restoration before focus
+    uint64_t computeContentVersion() const;
 
     // Display and formatting methods
     std::string toString() const;         // Enhanced with workspace info
@@ -107,4 +114,20 @@ struct WindowInfo {
     bool operator<(const WindowInfo& other) const;
 };
 
+/**
+ * Window state tallies, accumulated alongside another pass over a window list
+ */
+struct WindowStateCounts {
+    size_t visible = 0;
+    size_t minimized = 0;
+    size_t focused = 0;
+    size_t hidden = 0; // Not visible
+
+    void add(const WindowInfo& window) {
+        if (window.isVisible) visible++; else hidden++;
+        if (window.isMinimized) minimized++;
+        if (window.isFocused) focused++;
+    }
+};
+
 } // namespace WindowManager
\ No newline at end of file
@@ -37,7 +37,13 @@ WindowManager::WindowManager(std::unique_ptr<WindowEnumerator> enumerator,
     }
 }
 
-WindowManager::~WindowManager() = default;
+WindowManager::~WindowManager() {
+    // The background refresh uses the enumerator; let it finish first
+    std::lock_guard<std::mutex> lock(revalidationMutex_);
+    if (revalidation_.valid()) {
+        revalidation_.wait();
+    }
+}
 
 /**
  * @brief Retrieves all available windows from the system
@@ -46,18 +52,13 @@ WindowManager::~WindowManager() = default;
  * @throws WindowManagerException if window enumeration fails
  */
 std::vector<WindowInfo> WindowManager::getAllWindows() {
-    if (cachingEnabled_ && isCacheValid()) {
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        return cachedWindows_;
-    }
-
-    updateCache();
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    return cachedWindows_;
+    return getSnapshot()->windows;
 }
 
 bool WindowManager::refreshWindows() {
     try {
+        // Marks everything enumerated so far as stale, so only a pass starting now is joined
+        invalidateCache();
         updateCache();
         return true;
     } catch (const WindowManagerException&) {
@@ -77,11 +78,17 @@ FilterResult WindowManager::searchWindows(const std::string& keyword) {
  * @note Meets SC-002 requirement: filtering completes in <1 second
  */
 FilterResult WindowManager::searchWindows(const SearchQuery& query) {
+    auto start = std::chrono::steady_clock::now();
+
     // Get current windows (using cache if valid)
     auto windows = getAllWindows();
 
     // Apply filter
-    return filter_->filter(windows, query);
+    auto result = filter_->filter(windows, query);
+
+    recordSearchLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start));
+    return result;
 }
 
 FilterResult WindowManager::getEmptyResult(const SearchQuery& query) {
@@ -91,6 +98,92 @@ FilterResult WindowManager::getEmptyResult(const SearchQuery& query) {
     return FilterResult(std::move(emptyWindows), 0, query, searchTime);
 }
 
+bool WindowManager::waitForChanges(std::chrono::milliseconds timeout) {
+    noteChangeNotificationsConsumed();
+    bool changed = enumerator_->waitForChanges(timeout);
+
+    // Polling fallback reports every interval as a possible change; only trust
+    // real notifications enough to throw away a still-valid cache
+    if (changed && enumerator_->supportsChangeNotifications()) {
+        invalidateCache();
+        invalidateWorkspaceCache();
+    }
+
+    return changed;
+}
+
+void WindowManager::interruptWaitForChanges() {
+    enumerator_->interruptWaitForChanges();
+}
+
+bool WindowManager::supportsChangeNotifications() const {
+    return enumerator_->supportsChangeNotifications();
+}
+
+int WindowManager::getChangeNotificationFd() const {
+    return enumerator_->getChangeNotificationFd();
+}
+
+bool WindowManager::processChangeNotifications() {
+    noteChangeNotificationsConsumed();
+    return enumerator_->processChangeNotifications();
+}
+
+void WindowManager::noteChangeNotificationsConsumed() {
+    if (changeNotificationsConsumed_ || !enumerator_->supportsChangeNotifications()) {
+        return;
+    }
+    changeNotificationsConsumed_ = true;
+
+    // Events invalidate the caches from now on; the adaptive TTL only helps callers that poll
+    if (!adaptiveTtlConfigured_) {
+        adaptiveTtl_ = false;
+    }
+}
+
+void WindowManager::setChangeCoalescingLatency(std::chrono::milliseconds latency) {
+    enumerator_->setChangeCoalescingLatency(latency);
+}
+
+std::optional<std::chrono::steady_clock::time_point> WindowManager::getNextChangeDeadline() const {
+    return enumerator_->getNextChangeDeadline();
+}
+
+std::shared_ptr<const WindowSnapshot> WindowManager::getSnapshot() {
+    auto latest = getLatestSnapshot();
+    if (latest && cachingEnabled_ && isCacheValid()) {
+        return latest;
+    }
+    if (latest && cachingEnabled_ && canServeStale()) {
+        startRevalidation();
+        return latest;
+    }
+
+    updateCache();
+    return getLatestSnapshot();
+}
+
+std::shared_ptr<const WindowSnapshot> WindowManager::getLatestSnapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+WindowDelta WindowManager::getChangesSince(uint64_t generation) {
+    auto snapshot = getSnapshot();
+    if (!snapshot) {
+        return WindowDelta{generation, 0, true, {}, {}, {}};
+    }
+    return changeJournal_.changesSince(generation, *snapshot);
+}
+
+WindowDelta WindowManager::getChangesSince(uint64_t generation, const WindowSnapshot& target) const {
+    return changeJournal_.changesSince(generation, target);
+}
+
+std::optional<WindowThumbnail> WindowManager::captureThumbnail(const std::string& handle,
+                                                               unsigned int maxWidth, unsigned int maxHeight) {
+    return enumerator_->captureThumbnail(handle, maxWidth, maxHeight);
+}
+
 void WindowManager::enableCaching(bool enabled) {
     cachingEnabled_ = enabled;
     if (!enabled) {
@@ -108,17 +201,51 @@ bool WindowManager::isCachingEnabled() const {
 }
 
 void WindowManager::invalidateCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
+    // The last snapshot stays published for getLatestSnapshot(); it is just never served as fresh.
+    // The epoch keeps an enumeration already running from validating data older than this call.
+    ++invalidationEpoch_;
     cacheValid_ = false;
-    cachedWindows_.clear();
+}
+
+void WindowManager::setStaleWhileRevalidate(bool enabled, std::chrono::milliseconds maxStaleness) {
+    maxStalenessMs_ = maxStaleness.count();
+    staleWhileRevalidate_ = enabled;
+}
+
+bool WindowManager::isStaleWhileRevalidateEnabled() const {
+    return staleWhileRevalidate_;
+}
+
+void WindowManager::setCacheValidityDuration(std::chrono::milliseconds duration) {
+    cacheValidityMs_ = duration.count();
+    adaptiveTtlConfigured_ = true;
+    adaptiveTtl_ = false;
+}
+
+void WindowManager::setAdaptiveCacheTtl(bool enabled, std::chrono::milliseconds minimum,
+                                        std::chrono::milliseconds maximum) {
+    windowTtl_.setBounds(minimum, maximum);
+    workspaceTtl_.setBounds(2 * minimum, 2 * maximum);
+    adaptiveTtlConfigured_ = true;
+    adaptiveTtl_ = enabled;
+}
+
+bool WindowManager::isAdaptiveCacheTtlEnabled() const {
+    return adaptiveTtl_;
+}
+
+std::chrono::milliseconds WindowManager::getCacheAge() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - lastUpdate_.load());
 }
 
 std::chrono::milliseconds WindowManager::getLastUpdateTime() const {
-    return enumerator_->getLastEnumerationTime();
+    // Measured here: the enumerator's own figure is written by whichever thread enumerates
+    return lastEnumerationTime_.load();
 }
 
 size_t WindowManager::getTotalWindowCount() const {
-    return cachedWindows_.size();
+    auto snapshot = getLatestSnapshot();
+    return snapshot ? snapshot->windows.size() : 0;
 }
 
 std::string WindowManager::getSystemInfo() const {
@@ -127,8 +254,7 @@ std::string WindowManager::getSystemInfo() const {
 
 bool WindowManager::meetsPerformanceRequirements() const {
     // Check SC-001: Window enumeration in <3 seconds
-    auto enumerationTime = enumerator_->getLastEnumerationTime();
-    return enumerationTime <= MAX_ENUMERATION_TIME;
+    return getLastUpdateTime() <= MAX_ENUMERATION_TIME;
 }
 
 bool WindowManager::supportsRequiredWindowCount() const {
@@ -142,53 +268,165 @@ std::unique_ptr<WindowManager> WindowManager::create() {
     return std::make_unique<WindowManager>(std::move(enumerator));
 }
 
+std::unique_ptr<WindowManager> WindowManager::create(const std::vector<std::string>& displays) {
+    auto enumerator = WindowEnumerator::create(displays);
+    return std::make_unique<WindowManager>(std::move(enumerator));
+}
+
 // Private methods
+
+/**
+ * @brief Refreshes the window cache, coalescing concurrent callers
+ * @note Callers arriving while an enumeration is in flight wait for it and share its
+ *       result (or its exception) instead of starting another one, provided it started
+ *       after the latest invalidateCache(). An older pass is waited out and followed by
+ *       one more, so callers never get data from before they asked for fresh data.
+ */
 void WindowManager::updateCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
+    const uint64_t requestEpoch = invalidationEpoch_;
+    std::promise<void> completion;
+    uint64_t epoch = 0;
+
+    while (true) {
+        std::shared_future<void> inFlight;
+        bool current = false;
+        {
+            std::lock_guard<std::mutex> lock(refreshMutex_);
+            if (inFlightRefresh_.valid()) {
+                inFlight = inFlightRefresh_;
+                current = inFlightEpoch_ >= requestEpoch;
+            } else {
+                inFlightRefresh_ = completion.get_future().share();
+                inFlightEpoch_ = epoch = invalidationEpoch_;
+            }
+        }
+
+        if (!inFlight.valid()) {
+            break; // This caller enumerates
+        }
+        if (current) {
+            ++coalescedRefreshCount_;
+            inFlight.get(); // Rethrows the leader's enumeration failure
+            return;
+        }
+        inFlight.wait(); // Predates the request; its outcome is irrelevant here
+    }
+
+    std::exception_ptr failure;
+    try {
+        enumerateIntoCache(epoch);
+    } catch (...) {
+        failure = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        inFlightRefresh_ = std::shared_future<void>();
+    }
+    if (failure) {
+        completion.set_exception(failure);
+        std::rethrow_exception(failure);
+    }
+    completion.set_value();
+}
+
+void WindowManager::enumerateIntoCache(uint64_t epoch) {
+    ++enumerationCount_;
     auto start = std::chrono::steady_clock::now();
 
+    // Only the enumerator is held while the display server answers; readers keep
+    // copying the previous snapshot meanwhile
+    std::vector<WindowInfo> windows;
+    uint64_t serverRequests = 0;
     try {
-        auto windows = enumerator_->enumerateWindows();
+        std::lock_guard<std::mutex> lock(enumeratorMutex_);
+        uint64_t requestsBefore = enumerator_->getServerRequestCount();
+        windows = enumerator_->enumerateWindows();
+        serverRequests = enumerator_->getServerRequestCount() - requestsBefore;
+        lastEnumerationTime_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    } catch (const WindowManagerException&) {
+        cacheValid_ = false;
+        throw; // Re-throw to caller
+    }
 
-        // Memory management: Limit cache size to prevent excessive memory usage
+    // Memory management: Limit cache size to prevent excessive memory usage
+    if (windows.size() > MAX_CACHE_SIZE) {
+        // Keep only visible windows if we have too many
+        windows.erase(std::remove_if(windows.begin(), windows.end(),
+                                   [](const WindowInfo& w) { return !w.isVisible; }),
+                    windows.end());
+
+        // If still too many, keep only the first MAX_CACHE_SIZE
         if (windows.size() > MAX_CACHE_SIZE) {
-            // Keep only visible windows if we have too many
-            windows.erase(std::remove_if(windows.begin(), windows.end(),
-                                       [](const WindowInfo& w) { return !w.isVisible; }),
-                        windows.end());
-
-            // If still too many, keep only the first MAX_CACHE_SIZE
-            if (windows.size() > MAX_CACHE_SIZE) {
-                windows.resize(MAX_CACHE_SIZE);
-            }
+            windows.resize(MAX_CACHE_SIZE);
         }
+    }
 
-        cachedWindows_ = std::move(windows);
-        cacheValid_ = true;
-        lastUpdate_ = start;
-
-        // Performance optimization: Only sort if reasonable number of windows
-        if (cachedWindows_.size() <= 100) {
-            // Sort windows by title for consistent ordering
-            std::sort(cachedWindows_.begin(), cachedWindows_.end(),
-                      [](const WindowInfo& a, const WindowInfo& b) {
-                          return a.title < b.title;
-                      });
-        } else {
-            // For very large window counts, use stable_sort for better performance with pre-sorted data
-            std::stable_sort(cachedWindows_.begin(), cachedWindows_.end(),
-                           [](const WindowInfo& a, const WindowInfo& b) {
-                               return a.title < b.title;
-                           });
-        }
+    // Performance optimization: Only sort if reasonable number of windows
+    if (windows.size() <= 100) {
+        // Sort windows by title for consistent ordering
+        std::sort(windows.begin(), windows.end(),
+                  [](const WindowInfo& a, const WindowInfo& b) {
+                      return a.title < b.title;
+                  });
+    } else {
+        // For very large window counts, use stable_sort for better performance with pre-sorted data
+        std::stable_sort(windows.begin(), windows.end(),
+                       [](const WindowInfo& a, const WindowInfo& b) {
+                           return a.title < b.title;
+                       });
+    }
 
-    } catch (const WindowManagerException& e) {
-        cacheValid_ = false;
-        cachedWindows_.clear();
-        throw; // Re-throw to caller
+    WindowStateCounts stateCounts;
+    std::map<std::string, WindowStateCounts> workspaceStateCounts;
+    for (auto& window : windows) {
+        window.contentVersion = window.computeContentVersion();
+        stateCounts.add(window);
+        workspaceStateCounts[window.workspaceId].add(window);
     }
-}
+    size_t memoryBytes = estimateSnapshotMemory(windows);
 
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+
+    // Journal what changed since the previous snapshot; the result also feeds the adaptive TTL
+    // Bound by reference: a conditional with a temporary would copy the whole previous list
+    static const std::vector<WindowInfo> noWindows;
+    auto previous = getLatestSnapshot();
+    const std::vector<WindowInfo>& previousWindows = previous ? previous->windows : noWindows;
+    bool changed = changeJournal_.record(snapshotGeneration_ + 1, previousWindows, windows);
+    if (adaptiveTtl_) {
+        windowTtl_.recordRefresh(!previous || changed);
+    }
+
+    // Publish the sorted list as an immutable snapshot
+    auto snapshot = std::make_shared<WindowSnapshot>();
+    snapshot->generation = ++snapshotGeneration_;
+    snapshot->capturedAt = start;
+    snapshot->etag = computeEtag(windows);
+    snapshot->workspaceBuckets = workspaceIndex_.update(windows);
+    snapshot->stateCounts = stateCounts;
+    snapshot->workspaceStateCounts = std::move(workspaceStateCounts);
+    snapshot->enumerationCount = enumerationCount_.load();
+    snapshot->coalescedRefreshCount = coalescedRefreshCount_.load();
+    snapshot->cacheTtl = getEffectiveCacheTtl();
+    snapshot->titleChanges = enumerator_->getChangeCoalescingStats();
+    snapshot->windows = std::move(windows);
+    std::atomic_store(&snapshot_, std::shared_ptr<const WindowSnapshot>(std::move(snapshot)));
+
+    lastUpdate_ = start;
+    // Checked after the store: an invalidation racing with it is never overwritten
+    cacheValid_ = true;
+    if (invalidationEpoch_ != epoch) {
+        cacheValid_ = false; // Invalidated while enumerating: the data predates the change
+    }
+
+    {
+        std::lock_guard<std::mutex> metricsLock(metricsMutex_);
+        lastRefreshServerRequests_ = serverRequests;
+        snapshotMemoryBytes_ = memoryBytes;
+    }
+}
 
 bool WindowManager::isCacheValid() const {
     if (!cacheValid_) {
@@ -197,8 +435,36 @@ bool WindowManager::isCacheValid() const {
 
     // Cache is valid for the configured duration
     auto now = std::chrono::steady_clock::now();
-    auto cacheAge = std::chrono::duration_cast<std::chrono::seconds>(now - lastUpdate_);
-    return cacheAge < CACHE_VALIDITY_DURATION;
+    return now - lastUpdate_.load() < getEffectiveCacheTtl();
+}
+
+bool WindowManager::canServeStale() const {
+    if (!staleWhileRevalidate_) {
+        return false;
+    }
+
+    // Expired by age only: explicit invalidation means the data is known to be wrong
+    if (!cacheValid_) {
+        return false;
+    }
+    auto age = std::chrono::steady_clock::now() - lastUpdate_.load();
+    return age < std::chrono::milliseconds(maxStalenessMs_.load());
+}
+
+void WindowManager::startRevalidation() {
+    std::lock_guard<std::mutex> lock(revalidationMutex_);
+    if (revalidation_.valid() &&
+        revalidation_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return; // Already revalidating
+    }
+
+    revalidation_ = std::async(std::launch::async, [this]() {
+        try {
+            updateCache();
+        } catch (const WindowManagerException&) {
+            // The stale snapshot keeps being served until maxStaleness forces a blocking refresh
+        }
+    });
 }
 
 // T042: Operations for User Story 3 - Cross-Workspace Window Management
@@ -211,23 +477,75 @@ std::vector<WorkspaceInfo> WindowManager::getAllWorkspaces() {
         return defaultWorkspaces;
     }
 
+    auto workspaces = getWorkspaceList();
+    attachWindowHandles(workspaces);
+    return workspaces;
+}
+
+std::vector<WorkspaceInfo> WindowManager::getWorkspaceList() {
     // T046: Use workspace caching if enabled and valid
-    if (cachingEnabled_ && isWorkspaceCacheValid()) {
-        std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
-        return cachedWorkspaces_;
+    if (!cachingEnabled_ || !isWorkspaceCacheValid()) {
+        updateWorkspaceCache();
     }
-
-    updateWorkspaceCache();
     std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
     return cachedWorkspaces_;
 }
 
+WorkspaceStatistics WindowManager::getWorkspaceStatistics() {
+    auto snapshot = getSnapshot();
+    std::vector<WorkspaceInfo> workspaces;
+    if (enumerator_->isWorkspaceSupported()) {
+        workspaces = getWorkspaceList();
+    }
+    if (!snapshot) {
+        return WorkspaceStatistics::fromCounts({}, 0, workspaces, [](const std::string&) { return size_t{0}; });
+    }
+
+    // Counts and buckets were computed with the snapshot: nothing here walks the windows
+    auto buckets = snapshot->workspaceBuckets;
+    return WorkspaceStatistics::fromCounts(snapshot->stateCounts, snapshot->windows.size(), workspaces,
+                                           [&buckets](const std::string& id) {
+                                               return buckets ? buckets->countOn(id) : size_t{0};
+                                           });
+}
+
+void WindowManager::attachWindowHandles(std::vector<WorkspaceInfo>& workspaces) {
+    std::shared_ptr<const WindowSnapshot> snapshot;
+    try {
+        snapshot = getSnapshot();
+    } catch (const WindowManagerException&) {
+        return; // The workspace list is still useful without its membership
+    }
+    if (!snapshot || !snapshot->workspaceBuckets) {
+        return;
+    }
+    for (auto& workspace : workspaces) {
+        workspace.windowHandles = snapshot->workspaceBuckets->windowsOn(workspace.id);
+    }
+}
+
 std::optional<WorkspaceInfo> WindowManager::getCurrentWorkspace() {
     if (!enumerator_->isWorkspaceSupported()) {
         return std::nullopt;
     }
 
-    return enumerator_->getCurrentWorkspace();
+    // While change notifications are drained the platform keeps its own event-invalidated
+    // table, which is fresher than the TTL cache and just as cheap
+    if (changeNotificationsConsumed_ || !cachingEnabled_) {
+        std::lock_guard<std::mutex> lock(enumeratorMutex_);
+        return enumerator_->getCurrentWorkspace();
+    }
+
+    if (!isWorkspaceCacheValid()) {
+        updateWorkspaceCache();
+    }
+    std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
+    for (const auto& workspace : cachedWorkspaces_) {
+        if (workspace.isCurrent) {
+            return workspace;
+        }
+    }
+    return std::nullopt;
 }
 
 std::vector<WindowInfo> WindowManager::getAllWorkspaceWindows() {
@@ -236,6 +554,7 @@ std::vector<WindowInfo> WindowManager::getAllWorkspaceWindows() {
         return getAllWindows();
     }
 
+    std::lock_guard<std::mutex> lock(enumeratorMutex_);
     return enumerator_->enumerateAllWorkspaceWindows();
 }
 
@@ -245,10 +564,12 @@ std::vector<WindowInfo> WindowManager::getWindowsOnWorkspace(const std::string&
         return getAllWindows();
     }
 
+    std::lock_guard<std::mutex> lock(enumeratorMutex_);
     return enumerator_->getWindowsOnWorkspace(workspaceId);
 }
 
 std::optional<WindowInfo> WindowManager::getFocusedWindowAcrossWorkspaces() {
+    std::lock_guard<std::mutex> lock(enumeratorMutex_);
     if (!enumerator_->isWorkspaceSupported()) {
         // Fall back to standard focused window detection
         return enumerator_->getFocusedWindow();
@@ -284,30 +605,41 @@ FilterResult WindowManager::searchWindowsWithWorkspaces(const SearchQuery& query
 // T046: Performance monitoring and workspace caching implementation
 
 void WindowManager::updateWorkspaceCache() {
-    std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
     auto start = std::chrono::steady_clock::now();
 
+    // Enumerated without workspaceCacheMutex_, so readers of the cached list never wait on X
+    std::vector<WorkspaceInfo> workspaces;
     try {
-        auto workspaces = enumerator_->enumerateWorkspaces();
-        cachedWorkspaces_ = std::move(workspaces);
-        workspaceCacheValid_ = true;
-        lastWorkspaceUpdate_ = start;
+        std::lock_guard<std::mutex> enumeratorLock(enumeratorMutex_);
+        workspaces = enumerator_->enumerateWorkspaces();
+    } catch (const WindowManagerException&) {
+        invalidateWorkspaceCache();
+        throw; // Re-throw to caller
+    }
 
-        // Track performance metrics
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now() - start);
-        lastWorkspaceEnumerationTime_ = duration;
+    // Track performance metrics
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    lastWorkspaceEnumerationTime_ = duration;
 
-        // Performance logging if workspace enumeration is slow
-        if (duration > WORKSPACE_ENUMERATION_WARNING_THRESHOLD) {
-            // Could log warning here in a production system
-        }
+    // Performance logging if workspace enumeration is slow
+    if (duration > WORKSPACE_ENUMERATION_WARNING_THRESHOLD) {
+        // Could log warning here in a production system
+    }
 
-    } catch (const WindowManagerException& e) {
-        workspaceCacheValid_ = false;
-        cachedWorkspaces_.clear();
-        throw; // Re-throw to caller
+    std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
+    if (adaptiveTtl_) {
+        bool changed = workspaces.size() != cachedWorkspaces_.size() ||
+                       !std::equal(workspaces.begin(), workspaces.end(), cachedWorkspaces_.begin(),
+                                   [](const WorkspaceInfo& a, const WorkspaceInfo& b) {
+                                       return a == b && a.isCurrent == b.isCurrent && a.name == b.name;
+                                   });
+        workspaceTtl_.recordRefresh(changed);
     }
+    cachedWorkspaces_ = std::move(workspaces);
+    workspaceCount_ = cachedWorkspaces_.size();
+    lastWorkspaceUpdate_ = start;
+    workspaceCacheValid_ = true;
 }
 
 bool WindowManager::isWorkspaceCacheValid() const {
@@ -318,28 +650,36 @@ bool WindowManager::isWorkspaceCacheValid() const {
     // Workspace cache is valid for a longer duration than window cache
     // since workspaces change less frequently
     auto now = std::chrono::steady_clock::now();
-    auto cacheAge = std::chrono::duration_cast<std::chrono::seconds>(now - lastWorkspaceUpdate_);
-    return cacheAge < WORKSPACE_CACHE_VALIDITY_DURATION;
+    return now - lastWorkspaceUpdate_.load() < getEffectiveWorkspaceCacheTtl();
+}
+
+std::chrono::milliseconds WindowManager::getEffectiveCacheTtl() const {
+    return adaptiveTtl_ ? windowTtl_.current() : std::chrono::milliseconds(cacheValidityMs_.load());
+}
+
+std::chrono::milliseconds WindowManager::getEffectiveWorkspaceCacheTtl() const {
+    return adaptiveTtl_ ? workspaceTtl_.current()
+                        : std::chrono::milliseconds(WORKSPACE_CACHE_VALIDITY_DURATION);
 }
 
 void WindowManager::invalidateWorkspaceCache() {
     std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
     workspaceCacheValid_ = false;
     cachedWorkspaces_.clear();
+    workspaceCount_ = 0;
 }
 
 std::chrono::milliseconds WindowManager::getLastWorkspaceEnumerationTime() const {
-    return lastWorkspaceEnumerationTime_;
+    return lastWorkspaceEnumerationTime_.load();
 }
 
 size_t WindowManager::getWorkspaceCount() const {
-    std::lock_guard<std::mutex> lock(workspaceCacheMutex_);
-    return cachedWorkspaces_.size();
+    return workspaceCount_.load();
 }
 
 bool WindowManager::meetsWorkspacePerformanceRequirements() const {
     // Check workspace enumeration performance
-    return lastWorkspaceEnumerationTime_ <= WORKSPACE_ENUMERATION_WARNING_THRESHOLD;
+    return lastWorkspaceEnumerationTime_.load() <= WORKSPACE_ENUMERATION_WARNING_THRESHOLD;
 }
 
 PerformanceMetrics WindowManager::getPerformanceMetrics() const {
@@ -352,9 +692,61 @@ PerformanceMetrics WindowManager::getPerformanceMetrics() const {
     metrics.workspaceCacheValid = isWorkspaceCacheValid();
     metrics.meetsWindowPerformanceTarget = meetsPerformanceRequirements();
     metrics.meetsWorkspacePerformanceTarget = meetsWorkspacePerformanceRequirements();
+    metrics.filterCacheHitRatio = filter_->getCacheHitRatio();
+
+    std::vector<std::chrono::microseconds> latencies;
+    {
+        std::lock_guard<std::mutex> lock(metricsMutex_);
+        latencies = searchLatencies_;
+        metrics.lastRefreshServerRequests = lastRefreshServerRequests_;
+        metrics.snapshotMemoryBytes = snapshotMemoryBytes_;
+    }
+    metrics.windowEnumerationCount = enumerationCount_.load();
+    metrics.coalescedRefreshCount = coalescedRefreshCount_.load();
+    metrics.adaptiveCacheTtl = adaptiveTtl_;
+    metrics.effectiveCacheTtl = getEffectiveCacheTtl();
+    metrics.effectiveWorkspaceCacheTtl = getEffectiveWorkspaceCacheTtl();
+    metrics.observedChangeRate = windowTtl_.getChangeRate();
+
+    auto coalescing = enumerator_->getChangeCoalescingStats();
+    metrics.titleChangesReceived = coalescing.received;
+    metrics.titleChangesDelivered = coalescing.delivered;
+    metrics.titleCoalescingRatio = coalescing.ratio();
+
+    metrics.searchSampleCount = latencies.size();
+    if (!latencies.empty()) {
+        auto percentile = [&latencies](double fraction) {
+            auto position = latencies.begin() + static_cast<std::ptrdiff_t>(fraction * (latencies.size() - 1));
+            std::nth_element(latencies.begin(), position, latencies.end());
+            return *position;
+        };
+        metrics.searchLatencyP50 = percentile(0.50);
+        metrics.searchLatencyP95 = percentile(0.95);
+        metrics.searchLatencyP99 = percentile(0.99);
+    }
+
     return metrics;
 }
 
+void WindowManager::recordSearchLatency(std::chrono::microseconds latency) {
+    std::lock_guard<std::mutex> lock(metricsMutex_);
+    if (searchLatencies_.size() < SEARCH_LATENCY_SAMPLES) {
+        searchLatencies_.push_back(latency);
+    } else {
+        searchLatencies_[nextLatencySlot_] = latency;
+    }
+    nextLatencySlot_ = (nextLatencySlot_ + 1) % SEARCH_LATENCY_SAMPLES;
+}
+
+size_t WindowManager::estimateSnapshotMemory(const std::vector<WindowInfo>& windows) {
+    size_t bytes = windows.capacity() * sizeof(WindowInfo);
+    for (const auto& window : windows) {
+        bytes += window.handle.capacity() + window.title.capacity() + window.ownerName.capacity() +
+                 window.workspaceId.capacity() + window.workspaceName.capacity();
+    }
+    return bytes;
+}
+
 void WindowManager::refreshAllCaches() {
     // Invalidate and refresh both window and workspace caches
     invalidateCache();
@@ -457,6 +849,60 @@ bool WindowManager::focusWindowByHandle(const std::string& handle, bool allowWor
     }
 }
 
+bool WindowManager::focusWindowFromSnapshot(const WindowInfo& window, bool allowWorkspaceSwitch) {
+    if (!checkRateLimit()) {
+        return false;
+    }
+
+    FocusRequest request;
+    request.targetHandle = window.handle;
+    request.timestamp = std::chrono::steady_clock::now();
+    request.requestId = window.handle + "_" + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(
+        request.timestamp.time_since_epoch()).count());
+    request.crossWorkspace = !window.isOnCurrentWorkspace;
+    request.sourceWorkspace = "current";
+    request.targetWorkspace = window.workspaceId;
+
+    FocusOperation operation(request, FocusStatus::FOCUSING);
+
+    try {
+        recordFocusRequest();
+
+        if (!window.isOnCurrentWorkspace && !allowWorkspaceSwitch) {
+            operation.fail("Window requires workspace switch but not allowed");
+            addToFocusHistory(operation);
+            return false;
+        }
+
+        // The snapshot already carries the workspace, so no handle validation
+        // round trip and no getWindowInfo() lookup before focusing. The platform
+        // focusWindow() switches to the window's workspace itself.
+        std::unique_lock<std::mutex> enumeratorLock(enumeratorMutex_);
+        if (!window.isOnCurrentWorkspace && !window.workspaceId.empty() &&
+            enumerator_->canSwitchWorkspaces()) {
+            operation.setStatus(FocusStatus::SWITCHING_WORKSPACE);
+            operation.markWorkspaceSwitched();
+        }
+
+        bool success = enumerator_->focusWindow(window.handle);
+        enumeratorLock.unlock();
+
+        if (success) {
+            operation.complete();
+        } else {
+            operation.fail("Focus operation failed");
+        }
+
+        addToFocusHistory(operation);
+        return success;
+
+    } catch (const std::exception& e) {
+        operation.fail(e.what());
+        addToFocusHistory(operation);
+        return false;
+    }
+}
+
 bool WindowManager::validateHandle(const std::string& handle) {
     return validateHandleWithTimeout(handle, DEFAULT_VALIDATION_TIMEOUT);
 }
@@ -471,6 +917,7 @@ bool WindowManager::validateHandleWithTimeout(const std::string& handle, std::ch
 
     // Create a timeout mechanism using a separate thread or simple time check
     auto result = std::async(std::launch::async, [this, &handle]() {
+        std::lock_guard<std::mutex> lock(enumeratorMutex_);
         return enumerator_->isWindowValid(handle);
     });
 
@@ -499,6 +946,7 @@ bool WindowManager::validateHandleWithTimeout(const std::string& handle, std::ch
 
 std::optional<WindowInfo> WindowManager::getWindowByHandle(const std::string& handle) {
     // Use the enumerator to get window information
+    std::lock_guard<std::mutex> lock(enumeratorMutex_);
     return enumerator_->getWindowInfo(handle);
 }
 
@@ -506,7 +954,11 @@ bool WindowManager::focusWindowInCurrentWorkspace(const std::string& handle) {
     auto startTime = std::chrono::steady_clock::now();
 
     // Delegate to platform-specific focus implementation
-    bool success = enumerator_->focusWindow(handle);
+    bool success;
+    {
+        std::lock_guard<std::mutex> lock(enumeratorMutex_);
+        success = enumerator_->focusWindow(handle);
+    }
 
     auto endTime = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -531,22 +983,9 @@ bool WindowManager::focusWindowAcrossWorkspaces(const std::string& handle) {
             return false; // Window not found
         }
 
-        // Check if workspace switching is supported
-        if (!enumerator_->canSwitchWorkspaces()) {
-            // Fallback: attempt focus without workspace switching
-            return enumerator_->focusWindow(handle);
-        }
-
-        // Attempt to switch to target workspace first
-        if (!windowInfo->workspaceId.empty()) {
-            bool switchSuccess = enumerator_->switchToWorkspace(windowInfo->workspaceId);
-            if (!switchSuccess) {
-                // Workspace switch failed, try focusing anyway
-                return enumerator_->focusWindow(handle);
-            }
-        }
-
-        // Now focus the window (platform implementation will handle the details)
+        // The platform implementation switches to the window's workspace when it
+        // can, then focuses; without workspace support it just focuses
+        std::lock_guard<std::mutex> lock(enumeratorMutex_);
         bool focusSuccess = enumerator_->focusWindow(handle);
 
         auto endTime = std::chrono::steady_clock::now();
@@ -5,9 +5,14 @@
 #include "enumerator.hpp"
 #include "focus_request.hpp"
 #include "focus_operation.hpp"
+#include "window_snapshot.hpp"
+#include "adaptive_ttl.hpp"
+#include "change_journal.hpp"
 #include <memory>
 #include <vector>
 #include <chrono>
+#include <atomic>
+#include <future>
 #include <mutex>
 #include <optional>
 
@@ -16,6 +21,7 @@ namespace WindowManager {
 // Forward declarations for filtering support (User Story 2)
 struct SearchQuery;
 struct FilterResult;
+struct WorkspaceStatistics;
 class WindowFilter;
 
 // T046: Performance monitoring structure
@@ -28,6 +34,24 @@ struct PerformanceMetrics {
     bool workspaceCacheValid = false;
     bool meetsWindowPerformanceTarget = false;
     bool meetsWorkspacePerformanceTarget = false;
+
+    // Live diagnostics (interactive performance overlay)
+    std::chrono::microseconds searchLatencyP50{0};
+    std::chrono::microseconds searchLatencyP95{0};
+    std::chrono::microseconds searchLatencyP99{0};
+    size_t searchSampleCount = 0;
+    uint64_t lastRefreshServerRequests = 0; // Requests (round trips) of the last enumeration
+    double filterCacheHitRatio = 0.0;
+    size_t snapshotMemoryBytes = 0;         // Approximate size of the cached window snapshot
+    uint64_t windowEnumerationCount = 0;    // Enumerations actually performed
+    uint64_t coalescedRefreshCount = 0;     // Refresh requests that joined an in-flight enumeration
+    bool adaptiveCacheTtl = false;
+    std::chrono::milliseconds effectiveCacheTtl{0};          // TTL currently applied to the window cache
+    std::chrono::milliseconds effectiveWorkspaceCacheTtl{0};
+    double observedChangeRate = 0.0;                         // Share of recent refreshes that saw changes
+    uint64_t titleChangesReceived = 0;   // Title change notifications seen
+    uint64_t titleChangesDelivered = 0;  // ... that were let through after coalescing
+    double titleCoalescingRatio = 0.0;   // Share of title changes folded into another update
 };
 
 /**
@@ -50,7 +74,7 @@ public:
 
     // Primary operations for User Story 1
     std::vector<WindowInfo> getAllWindows();
-    bool refreshWindows();
+    bool refreshWindows(); // Data enumerated after the call; never joins an older refresh
 
     // Operations for User Story 2 - Keyword Filtering
     FilterResult searchWindows(const std::string& keyword);
@@ -58,12 +82,13 @@ public:
     FilterResult getEmptyResult(const SearchQuery& query);
 
     // T042: Operations for User Story 3 - Cross-Workspace Window Management
-    std::vector<WorkspaceInfo> getAllWorkspaces();
-    std::optional<WorkspaceInfo> getCurrentWorkspace();
+    std::vector<WorkspaceInfo> getAllWorkspaces(); // WorkspaceInfo::windowHandles from the current snapshot
+    std::optional<WorkspaceInfo> getCurrentWorkspace(); // Cached; cheap enough to poll
     std::vector<WindowInfo> getAllWorkspaceWindows();
     std::vector<WindowInfo> getWindowsOnWorkspace(const std::string& workspaceId);
     std::optional<WindowInfo> getFocusedWindowAcrossWorkspaces();
     FilterResult searchWindowsWithWorkspaces(const SearchQuery& query);
+    WorkspaceStatistics getWorkspaceStatistics(); // Precomputed with the snapshot; O(workspaces)
 
     // NEW: Window Focus Operations (from contracts/focus_api.md)
     bool focusWindowByHandle(const std::string& handle, bool allowWorkspaceSwitch = true);
@@ -73,16 +98,67 @@ public:
     bool focusWindowInCurrentWorkspace(const std::string& handle);
     bool focusWindowAcrossWorkspaces(const std::string& handle);
 
+    // Focus fast path for callers holding a fresh snapshot (e.g. the interactive switcher):
+    // trusts the snapshot instead of re-validating and re-querying the handle
+    bool focusWindowFromSnapshot(const WindowInfo& window, bool allowWorkspaceSwitch = true);
+
     // T045: FocusOperation tracking and history
     std::vector<FocusOperation> getFocusHistory() const;
     std::optional<FocusOperation> getLastFocusOperation() const;
     void clearFocusHistory();
 
+    // Event-driven refresh: blocks until the window set may have changed (or timeout).
+    // On platforms with change notifications an observed change invalidates the cache.
+    bool waitForChanges(std::chrono::milliseconds timeout);
+    void interruptWaitForChanges(); // Ends a blocked waitForChanges() early; any thread
+    bool supportsChangeNotifications() const;
+
+    // Non-blocking variant for event loops: drains pending notifications and reports
+    // whether anything relevant changed. Caches are left alone; callers refresh.
+    int getChangeNotificationFd() const;
+    bool processChangeNotifications();
+
+    // Title-change bursts are coalesced per window (0 disables). While changes are held,
+    // getNextChangeDeadline() says when processChangeNotifications() will report them.
+    void setChangeCoalescingLatency(std::chrono::milliseconds latency);
+    std::optional<std::chrono::steady_clock::time_point> getNextChangeDeadline() const;
+
+    // Immutable snapshots of the window list
+    std::shared_ptr<const WindowSnapshot> getSnapshot();              // Refreshes a stale cache first
+    std::shared_ptr<const WindowSnapshot> getLatestSnapshot() const;  // Never blocks; may be stale or null
+
+    // Incremental sync: what changed after `generation`. Falls back to a full snapshot
+    // (WindowDelta::fullSnapshot) for generation 0 or once the journal has dropped it.
+    WindowDelta getChangesSince(uint64_t generation);                                   // Refreshes like getSnapshot()
+    WindowDelta getChangesSince(uint64_t generation, const WindowSnapshot& target) const; // Up to a snapshot already held
+
+    // Window content preview (never cached here; callers rate-limit captures)
+    std::optional<WindowThumbnail> captureThumbnail(const std::string& handle,
+                                                    unsigned int maxWidth, unsigned int maxHeight);
+
     // Performance and state management
     void enableCaching(bool enabled);
     bool isCachingEnabled() const;
     void invalidateCache();
 
+    // Stale-while-revalidate: once the cache expires, keep serving the last snapshot
+    // (up to maxStaleness old) while one background refresh runs. An explicitly
+    // invalidated cache is always refreshed synchronously; refreshWindows() forces fresh data.
+    static constexpr std::chrono::milliseconds DEFAULT_MAX_STALENESS{30000};
+    void setStaleWhileRevalidate(bool enabled, std::chrono::milliseconds maxStaleness = DEFAULT_MAX_STALENESS);
+    bool isStaleWhileRevalidateEnabled() const;
+    std::chrono::milliseconds getCacheAge() const; // Age of the data getAllWindows() would return
+    void setCacheValidityDuration(std::chrono::milliseconds duration); // Fixed TTL; disables the adaptive TTL
+
+    // Adaptive TTL: shrinks after refreshes that found changes and grows on idle ones.
+    // Enabled by default until change notifications are first consumed (waitForChanges() /
+    // processChangeNotifications()); the workspace cache uses twice the window bounds.
+    static constexpr std::chrono::milliseconds DEFAULT_MIN_CACHE_TTL{500};
+    static constexpr std::chrono::milliseconds DEFAULT_MAX_CACHE_TTL{30000};
+    void setAdaptiveCacheTtl(bool enabled, std::chrono::milliseconds minimum = DEFAULT_MIN_CACHE_TTL,
+                             std::chrono::milliseconds maximum = DEFAULT_MAX_CACHE_TTL);
+    bool isAdaptiveCacheTtlEnabled() const;
+
     // Diagnostics and monitoring
     std::chrono::milliseconds getLastUpdateTime() const;
     size_t getTotalWindowCount() const;
@@ -96,28 +172,67 @@ public:
     std::chrono::milliseconds getLastWorkspaceEnumerationTime() const;
     size_t getWorkspaceCount() const;
     bool meetsWorkspacePerformanceRequirements() const;
-    PerformanceMetrics getPerformanceMetrics() const;
+    PerformanceMetrics getPerformanceMetrics() const; // Lock-free reads; safe from a UI or event-loop thread
     void invalidateWorkspaceCache();
     void refreshAllCaches();
 
     // Factory method
     static std::unique_ptr<WindowManager> create();
+    static std::unique_ptr<WindowManager> create(const std::vector<std::string>& displays); // Empty = default display
 
 private:
     std::unique_ptr<WindowEnumerator> enumerator_;
     std::unique_ptr<WindowFilter> filter_;
-    std::vector<WindowInfo> cachedWindows_;
-    std::chrono::steady_clock::time_point lastUpdate_;
-    bool cachingEnabled_ = true;
-    bool cacheValid_ = false;
-    mutable std::mutex cacheMutex_;
+
+    // Serialises every call that talks to the display server through the enumerator.
+    // Change notifications (own event connection) and thumbnail captures (own capture
+    // connection) are not serialised with it.
+    mutable std::mutex enumeratorMutex_;
+
+    // Readers never lock: they check these flags and copy from snapshot_
+    std::atomic<std::chrono::steady_clock::time_point> lastUpdate_; // capturedAt of the valid snapshot
+    std::atomic<bool> cachingEnabled_{true};
+    std::atomic<bool> cacheValid_{false};
+    std::atomic<uint64_t> invalidationEpoch_{0}; // Bumped by invalidateCache()
+    std::atomic<std::chrono::milliseconds> lastEnumerationTime_{std::chrono::milliseconds(0)};
+    mutable std::mutex cacheMutex_; // Serialises snapshot publication
+
+    // Published on every cache refresh (std::atomic_load/atomic_store); the window cache
+    std::shared_ptr<const WindowSnapshot> snapshot_;
+    uint64_t snapshotGeneration_ = 0; // Guarded by cacheMutex_
+    ChangeJournal changeJournal_;     // Appended under cacheMutex_; synchronises its own readers
+    WorkspaceIndex workspaceIndex_;   // Guarded by cacheMutex_
+
+    // Single-flight refresh: concurrent callers share the enumeration in progress
+    std::mutex refreshMutex_;
+    std::shared_future<void> inFlightRefresh_; // Valid while an enumeration runs
+    uint64_t inFlightEpoch_ = 0;               // invalidationEpoch_ when it started
+    std::atomic<uint64_t> enumerationCount_{0};
+    std::atomic<uint64_t> coalescedRefreshCount_{0};
+
+    // Stale-while-revalidate state
+    std::atomic<bool> staleWhileRevalidate_{false};
+    std::atomic<long long> maxStalenessMs_{DEFAULT_MAX_STALENESS.count()};
+    std::atomic<long long> cacheValidityMs_{std::chrono::milliseconds(CACHE_VALIDITY_DURATION).count()};
+
+    // Adaptive TTLs (recordRefresh under cacheMutex_ / workspaceCacheMutex_ respectively)
+    std::atomic<bool> adaptiveTtl_{true};
+    std::atomic<bool> adaptiveTtlConfigured_{false}; // Set explicitly; consuming notifications leaves it alone
+    std::atomic<bool> changeNotificationsConsumed_{false};
+    AdaptiveTtl windowTtl_{DEFAULT_MIN_CACHE_TTL, DEFAULT_MAX_CACHE_TTL, CACHE_VALIDITY_DURATION};
+    AdaptiveTtl workspaceTtl_{2 * DEFAULT_MIN_CACHE_TTL, 2 * DEFAULT_MAX_CACHE_TTL, WORKSPACE_CACHE_VALIDITY_DURATION};
+    std::mutex revalidationMutex_;
+    std::future<void> revalidation_; // Background refresh; joined by the destructor
 
     // T046: Workspace caching and performance monitoring
+    // The mutex guards the list only and is never held across an enumeration; the
+    // scalars are atomics so getPerformanceMetrics() is safe from any thread
     std::vector<WorkspaceInfo> cachedWorkspaces_;
-    std::chrono::steady_clock::time_point lastWorkspaceUpdate_;
-    bool workspaceCacheValid_ = false;
     mutable std::mutex workspaceCacheMutex_;
-    std::chrono::milliseconds lastWorkspaceEnumerationTime_{0};
+    std::atomic<std::chrono::steady_clock::time_point> lastWorkspaceUpdate_{};
+    std::atomic<bool> workspaceCacheValid_{false};
+    std::atomic<size_t> workspaceCount_{0};
+    std::atomic<std::chrono::milliseconds> lastWorkspaceEnumerationTime_{std::chrono::milliseconds(0)};
 
     // Performance thresholds from specification
     static constexpr std::chrono::milliseconds MAX_ENUMERATION_TIME{3000}; // 3 seconds (SC-001)
@@ -138,17 +253,32 @@ private:
     mutable std::mutex rateLimitMutex_;
     std::vector<std::chrono::steady_clock::time_point> focusRequestTimes_;
 
+    // Live diagnostics reported through getPerformanceMetrics()
+    mutable std::mutex metricsMutex_;
+    std::vector<std::chrono::microseconds> searchLatencies_; // Ring buffer of recent searches
+    size_t nextLatencySlot_ = 0;
+    uint64_t lastRefreshServerRequests_ = 0;
+    size_t snapshotMemoryBytes_ = 0;
+    static constexpr size_t SEARCH_LATENCY_SAMPLES = 256;
+
     // T045: FocusOperation tracking and history
     mutable std::mutex focusHistoryMutex_;
     std::vector<FocusOperation> focusHistory_;
     static constexpr size_t MAX_FOCUS_HISTORY_SIZE = 1000; // Limit history to prevent memory growth
 
     // Cache management
-    void updateCache();
+    void updateCache();          // Single-flight entry point
+    void enumerateIntoCache(uint64_t epoch); // Performs one enumeration; `epoch` read before it starts
     bool isCacheValid() const;
+    std::chrono::milliseconds getEffectiveCacheTtl() const;
+    std::chrono::milliseconds getEffectiveWorkspaceCacheTtl() const;
+    bool canServeStale() const;
+    void startRevalidation();
 
     // T046: Workspace cache management
     void updateWorkspaceCache();
+    void attachWindowHandles(std::vector<WorkspaceInfo>& workspaces);
+    std::vector<WorkspaceInfo> getWorkspaceList(); // Cached, without window handles
     bool isWorkspaceCacheValid() const;
 
     // T039: Rate limiting helpers
@@ -157,6 +287,13 @@ private:
 
     // T045: Focus operation tracking helpers
     void addToFocusHistory(const FocusOperation& operation);
+
+    // Hands cache invalidation over to change notifications once someone drains them
+    void noteChangeNotificationsConsumed();
+
+    // Diagnostics helpers
+    void recordSearchLatency(std::chrono::microseconds latency);
+    static size_t estimateSnapshotMemory(const std::vector<WindowInfo>& windows);
 };
 
 } // namespace WindowManager
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "window.hpp"
+#include "workspace_index.hpp"
+#include "change_coalescer.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Immutable, versioned copy of the window list
+ * Published as std::shared_ptr<const WindowSnapshot>; readers never need a lock
+ */
+struct WindowSnapshot {
+    uint64_t generation = 0;                          // Increases with every refresh
+    uint64_t etag = 0;                                // Content hash; unchanged by refreshes that found nothing new
+    std::chrono::steady_clock::time_point capturedAt;
+    std::vector<WindowInfo> windows;
+    std::shared_ptr<const WorkspaceBuckets> workspaceBuckets; // Workspace membership of `windows`; may be null
+    WindowStateCounts stateCounts;                            // Tallied while the snapshot is built
+    std::map<std::string, WindowStateCounts> workspaceStateCounts; // The same tally, per workspace id
+
+    // Refresh diagnostics as of publication: stats readers never have to call into the manager
+    uint64_t enumerationCount = 0;
+    uint64_t coalescedRefreshCount = 0;
+    std::chrono::milliseconds cacheTtl{0};
+    ChangeCoalescingStats titleChanges;
+
+    std::chrono::milliseconds age() const {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - capturedAt);
+    }
+
+    const WindowInfo* findWindow(const std::string& handle) const {
+        for (const auto& window : windows) {
+            if (window.handle == handle) {
+                return &window;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/**
+ * ETag of a window list: order-sensitive fold of the windows' content versions
+ * Equal lists always give equal tags, so a poller can skip unchanged results.
+ */
+inline constexpr uint64_t EMPTY_ETAG = 14695981039346656037ull;
+
+inline uint64_t appendEtag(uint64_t etag, const WindowInfo& window) {
+    uint64_t version = window.contentVersion != 0 ? window.contentVersion : window.computeContentVersion();
+    return (etag ^ version) * 1099511628211ull + (etag >> 29);
+}
+
+inline uint64_t computeEtag(const std::vector<WindowInfo>& windows) {
+    uint64_t etag = EMPTY_ETAG;
+    for (const auto& window : windows) {
+        etag = appendEtag(etag, window);
+    }
+    return etag;
+}
+
+inline std::string formatEtag(uint64_t etag) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(etag));
+    return buffer;
+}
+
+} // namespace WindowManager
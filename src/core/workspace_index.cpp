@@ -0,0 +1,96 @@
+#include "workspace_index.hpp"
+
+namespace WindowManager {
+
+const std::vector<std::string>& WorkspaceBuckets::windowsOn(const std::string& workspaceId) const {
+    static const std::vector<std::string> empty;
+    auto it = handles.find(workspaceId);
+    return it != handles.end() ? *it->second : empty;
+}
+
+size_t WorkspaceBuckets::countOn(const std::string& workspaceId) const {
+    auto it = handles.find(workspaceId);
+    return it != handles.end() ? it->second->size() : 0;
+}
+
+size_t WorkspaceBuckets::totalWindows() const {
+    size_t total = 0;
+    for (const auto& bucket : handles) {
+        total += bucket.second->size();
+    }
+    return total;
+}
+
+std::shared_ptr<const WorkspaceBuckets> WorkspaceIndex::update(const std::vector<WindowInfo>& windows) {
+    ++pass_;
+    std::set<std::string> dirty;
+    size_t seen = 0;
+
+    for (const auto& window : windows) {
+        auto [it, inserted] = members_.try_emplace(window.handle, Member{window.workspaceId, pass_});
+        if (inserted) {
+            buckets_[window.workspaceId].insert(window.handle);
+            dirty.insert(window.workspaceId);
+            ++seen;
+            continue;
+        }
+
+        Member& member = it->second;
+        if (member.lastSeen == pass_) {
+            continue; // Duplicate handle
+        }
+        member.lastSeen = pass_;
+        ++seen;
+
+        if (member.workspaceId != window.workspaceId) {
+            buckets_[member.workspaceId].erase(window.handle);
+            buckets_[window.workspaceId].insert(window.handle);
+            dirty.insert(member.workspaceId);
+            dirty.insert(window.workspaceId);
+            member.workspaceId = window.workspaceId;
+        }
+    }
+
+    // Only scan for vanished windows when some were not seen
+    if (seen != members_.size()) {
+        for (auto it = members_.begin(); it != members_.end();) {
+            if (it->second.lastSeen != pass_) {
+                buckets_[it->second.workspaceId].erase(it->first);
+                dirty.insert(it->second.workspaceId);
+                it = members_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (dirty.empty() && published_) {
+        return published_;
+    }
+
+    auto buckets = published_ ? std::make_shared<WorkspaceBuckets>(*published_)
+                              : std::make_shared<WorkspaceBuckets>();
+    for (const auto& workspaceId : dirty) {
+        auto it = buckets_.find(workspaceId);
+        if (it == buckets_.end() || it->second.empty()) {
+            if (it != buckets_.end()) {
+                buckets_.erase(it);
+            }
+            buckets->handles.erase(workspaceId);
+        } else {
+            buckets->handles[workspaceId] =
+                std::make_shared<const std::vector<std::string>>(it->second.begin(), it->second.end());
+        }
+    }
+
+    published_ = std::move(buckets);
+    return published_;
+}
+
+void WorkspaceIndex::clear() {
+    members_.clear();
+    buckets_.clear();
+    published_.reset();
+}
+
+} // namespace WindowManager
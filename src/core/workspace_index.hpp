@@ -0,0 +1,55 @@
+#pragma once
+
+#include "window.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Workspace id -> handles of the windows on it, as of one snapshot
+ * Buckets are shared between snapshots and only rebuilt for workspaces whose
+ * membership changed. Handles within a bucket are sorted; empty workspaces have no bucket.
+ */
+struct WorkspaceBuckets {
+    std::map<std::string, std::shared_ptr<const std::vector<std::string>>> handles;
+
+    const std::vector<std::string>& windowsOn(const std::string& workspaceId) const;
+    size_t countOn(const std::string& workspaceId) const;
+    size_t totalWindows() const;
+};
+
+/**
+ * Incrementally maintained workspace membership of the cached windows
+ * update() checks each window against the workspace recorded for its handle last
+ * time and only moves handles that changed workspace, appeared or disappeared: a
+ * refresh in which one window changed desktop rebuilds two buckets.
+ *
+ * Not thread-safe (updated under WindowManager's cache lock); the published
+ * buckets are immutable.
+ */
+class WorkspaceIndex {
+public:
+    // Buckets for `windows`; the previously published pointer when membership is unchanged
+    std::shared_ptr<const WorkspaceBuckets> update(const std::vector<WindowInfo>& windows);
+    std::shared_ptr<const WorkspaceBuckets> current() const { return published_; }
+    void clear();
+
+private:
+    struct Member {
+        std::string workspaceId;
+        uint64_t lastSeen; // update() pass that last saw the handle
+    };
+
+    std::unordered_map<std::string, Member> members_;
+    std::map<std::string, std::set<std::string>> buckets_;
+    std::shared_ptr<const WorkspaceBuckets> published_;
+    uint64_t pass_ = 0;
+};
+
+} // namespace WindowManager
@@ -0,0 +1,53 @@
+#include "batch_runner.hpp"
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace WindowManager {
+
+BatchRunner::BatchRunner(WindowManager& windowManager, std::istream& input, std::ostream& output,
+                         FlushMode flushMode)
+    : windowManager_(windowManager)
+    , input_(input)
+    , output_(output)
+    , flushMode_(flushMode)
+    , handler_(windowManager,
+               // Refreshes only when the cache has gone stale, so consecutive queries share one enumeration
+               [this]() { return windowManager_.getSnapshot(); },
+               [](RequestHandler::XTask task, RequestHandler::Reply reply) { reply(task()); }) {
+}
+
+size_t BatchRunner::run() {
+    size_t failures = 0;
+    std::string line;
+
+    while (std::getline(input_, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back(); // CRLF scripts
+        }
+        if (line.empty()) {
+            if (flushMode_ == FlushMode::PerBatch) {
+                output_.flush();
+            }
+            continue;
+        }
+        if (line[0] == '#') {
+            continue; // Comments in batch scripts
+        }
+
+        handler_.handle(line, [&](RequestHandler::Response response) {
+            if (!response.ok) {
+                ++failures;
+            }
+            output_ << response.line << '\n';
+            if (flushMode_ == FlushMode::PerResponse) {
+                output_.flush();
+            }
+        });
+    }
+
+    output_.flush();
+    return failures;
+}
+
+} // namespace WindowManager
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "request_handler.hpp"
+#include "../core/window_manager.hpp"
+#include <iosfwd>
+
+namespace WindowManager {
+
+/**
+ * Batch mode: runs newline-delimited requests from a stream against one warm
+ * WindowManager, in order, using the daemon's line protocol. Requests that need
+ * the display server run inline, so responses come out in request order.
+ */
+class BatchRunner {
+public:
+    enum class FlushMode {
+        PerResponse,   // Flush after every response (interactive pipes)
+        PerBatch       // Flush at blank lines and at end of input
+    };
+
+    BatchRunner(WindowManager& windowManager, std::istream& input, std::ostream& output,
+                FlushMode flushMode = FlushMode::PerResponse);
+
+    // Processes input until EOF; returns the number of failed requests
+    size_t run();
+
+private:
+    WindowManager& windowManager_;
+    std::istream& input_;
+    std::ostream& output_;
+    FlushMode flushMode_;
+    RequestHandler handler_;
+};
+
+} // namespace WindowManager
@@ -0,0 +1,194 @@
+#include "event_loop.hpp"
+#include "../core/exceptions.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace WindowManager {
+
+namespace {
+
+constexpr int MAX_EVENTS_PER_WAIT = 64;
+
+} // namespace
+
+EventLoop::EventLoop()
+    : epollFd_(epoll_create1(EPOLL_CLOEXEC))
+    , wakeupFd_(-1) {
+
+    if (epollFd_ < 0) {
+        throw PlatformApiException("epoll_create1", errno, std::strerror(errno));
+    }
+
+    wakeupFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeupFd_ < 0) {
+        int error = errno;
+        close(epollFd_);
+        throw PlatformApiException("eventfd", error, std::strerror(error));
+    }
+
+    addFd(wakeupFd_, EPOLLIN, [this](uint32_t) {
+        uint64_t count;
+        while (read(wakeupFd_, &count, sizeof(count)) > 0) {
+        }
+        runPendingTasks();
+    });
+}
+
+EventLoop::~EventLoop() {
+    for (const auto& timer : timerCallbacks_) {
+        close(timer.first);
+    }
+    close(wakeupFd_);
+    close(epollFd_);
+}
+
+void EventLoop::addFd(int fd, uint32_t events, FdCallback callback) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+        throw PlatformApiException("epoll_ctl(ADD)", errno, std::strerror(errno));
+    }
+    fdCallbacks_[fd] = std::move(callback);
+}
+
+void EventLoop::modifyFd(int fd, uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event) < 0) {
+        throw PlatformApiException("epoll_ctl(MOD)", errno, std::strerror(errno));
+    }
+}
+
+void EventLoop::removeFd(int fd) {
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    fdCallbacks_.erase(fd);
+}
+
+int EventLoop::addTimer(std::chrono::milliseconds interval, bool repeating, TimerCallback callback) {
+    int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd < 0) {
+        throw PlatformApiException("timerfd_create", errno, std::strerror(errno));
+    }
+
+    // A zero it_value would disarm the timer - fire "immediately" instead
+    auto nanoseconds = std::max<long long>(1, std::chrono::duration_cast<std::chrono::nanoseconds>(interval).count());
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(nanoseconds / 1000000000LL);
+    spec.it_value.tv_nsec = static_cast<long>(nanoseconds % 1000000000LL);
+    if (repeating) {
+        spec.it_interval = spec.it_value;
+    }
+    timerfd_settime(timerFd, 0, &spec, nullptr);
+
+    timerCallbacks_[timerFd] = std::move(callback);
+    addFd(timerFd, EPOLLIN, [this, timerFd, repeating](uint32_t) {
+        uint64_t expirations;
+        if (read(timerFd, &expirations, sizeof(expirations)) <= 0) {
+            return;
+        }
+
+        // Keep the callback alive even if it cancels its own timer
+        auto it = timerCallbacks_.find(timerFd);
+        if (it == timerCallbacks_.end()) {
+            return;
+        }
+        TimerCallback callback = it->second;
+        if (!repeating) {
+            cancelTimer(timerFd);
+        }
+        callback();
+    });
+
+    return timerFd;
+}
+
+void EventLoop::cancelTimer(int timerId) {
+    if (timerCallbacks_.erase(timerId) == 0) {
+        return;
+    }
+    removeFd(timerId);
+    close(timerId);
+}
+
+void EventLoop::post(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        pendingTasks_.push_back(std::move(task));
+    }
+    wakeup();
+}
+
+void EventLoop::stop() {
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        stopRequested_ = true;
+    }
+    wakeup();
+}
+
+void EventLoop::run() {
+    epoll_event events[MAX_EVENTS_PER_WAIT];
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(taskMutex_);
+            if (stopRequested_) {
+                stopRequested_ = false;
+                break;
+            }
+        }
+
+        int count = epoll_wait(epollFd_, events, MAX_EVENTS_PER_WAIT, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw PlatformApiException("epoll_wait", errno, std::strerror(errno));
+        }
+
+        for (int i = 0; i < count; ++i) {
+            dispatch(events[i].data.fd, events[i].events);
+        }
+    }
+}
+
+void EventLoop::dispatch(int fd, uint32_t events) {
+    // The fd may have been removed by an earlier callback in the same batch
+    auto it = fdCallbacks_.find(fd);
+    if (it == fdCallbacks_.end()) {
+        return;
+    }
+    FdCallback callback = it->second;
+    callback(events);
+}
+
+void EventLoop::runPendingTasks() {
+    std::vector<Task> tasks;
+    {
+        std::lock_guard<std::mutex> lock(taskMutex_);
+        tasks.swap(pendingTasks_);
+    }
+    for (auto& task : tasks) {
+        task();
+    }
+}
+
+void EventLoop::wakeup() {
+    uint64_t one = 1;
+    ssize_t written = write(wakeupFd_, &one, sizeof(one));
+    (void)written; // EAGAIN means a wakeup is already pending
+}
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "platform_config.h"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Single-threaded epoll event loop
+ * Multiplexes file descriptors, timers (timerfd) and tasks posted from other
+ * threads (eventfd wakeup). All callbacks run on the thread calling run().
+ */
+class EventLoop {
+public:
+    using FdCallback = std::function<void(uint32_t events)>;
+    using TimerCallback = std::function<void()>;
+    using Task = std::function<void()>;
+
+    EventLoop();
+    ~EventLoop();
+
+    // Non-copyable, non-moveable (owns the epoll instance)
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+    EventLoop(EventLoop&&) = delete;
+    EventLoop& operator=(EventLoop&&) = delete;
+
+    // File descriptors (loop thread only); the caller keeps ownership of the fd
+    void addFd(int fd, uint32_t events, FdCallback callback);
+    void modifyFd(int fd, uint32_t events);
+    void removeFd(int fd);
+
+    // Timers (loop thread only); returns an id for cancelTimer()
+    int addTimer(std::chrono::milliseconds interval, bool repeating, TimerCallback callback);
+    void cancelTimer(int timerId);
+
+    // Thread-safe
+    void post(Task task);
+    void stop();
+
+    // Runs until stop() is called
+    void run();
+
+private:
+    int epollFd_;
+    int wakeupFd_;
+
+    std::unordered_map<int, FdCallback> fdCallbacks_;
+    std::unordered_map<int, TimerCallback> timerCallbacks_; // Keyed by timerfd
+
+    std::mutex taskMutex_;
+    std::vector<Task> pendingTasks_;
+    bool stopRequested_ = false; // Guarded by taskMutex_
+
+    void dispatch(int fd, uint32_t events);
+    void runPendingTasks();
+    void wakeup();
+};
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
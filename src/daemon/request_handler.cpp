@@ -0,0 +1,395 @@
+#include "request_handler.hpp"
+#include "../filters/search_query.hpp"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+
+namespace WindowManager {
+
+RequestHandler::RequestHandler(WindowManager& windowManager, SnapshotProvider snapshots, XExecutor executor)
+    : windowManager_(windowManager)
+    , snapshots_(std::move(snapshots))
+    , executor_(std::move(executor)) {
+
+    if (!snapshots_ || !executor_) {
+        throw std::invalid_argument("RequestHandler requires a snapshot provider and an X executor");
+    }
+}
+
+void RequestHandler::setStatsProvider(StatsProvider provider) {
+    statsProvider_ = std::move(provider);
+}
+
+void RequestHandler::handle(const std::string& line, Reply reply) {
+    std::string request = line;
+    if (!request.empty() && request.back() == '\r') {
+        request.pop_back();
+    }
+
+    auto firstChar = request.find_first_not_of(" \t");
+    if (firstChar != std::string::npos && request[firstChar] == '{') {
+        auto converted = parseJsonRequest(request);
+        if (!converted) {
+            reply({formatError("", "malformed JSON request"), false});
+            return;
+        }
+        request = *converted;
+    }
+
+    auto separator = request.find(' ');
+    std::string command = request.substr(0, separator);
+    std::string argument = separator == std::string::npos ? "" : request.substr(separator + 1);
+    auto ifChanged = takeOption(argument, "--if-changed");
+
+    try {
+        if (command == "ping") {
+            reply({R"({"ok":true,"command":"ping"})", true});
+            return;
+        }
+
+        if (command == "list" || command == "search" || command == "stats") {
+            auto snapshot = snapshots_();
+            if (!snapshot) {
+                reply({formatError(command, "no window snapshot available yet"), false});
+                return;
+            }
+
+            if (command == "stats") {
+                std::ostringstream oss;
+                auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - snapshot->capturedAt);
+                oss << R"({"ok":true,"command":"stats","generation":)" << snapshot->generation
+                    << R"(,"windows":)" << snapshot->windows.size()
+                    << R"(,"snapshotAgeMs":)" << age.count();
+                // Snapshot only: the X owner may be enumerating right now
+                oss << R"(,"enumerations":)" << snapshot->enumerationCount
+                    << R"(,"coalescedRefreshes":)" << snapshot->coalescedRefreshCount
+                    << R"(,"cacheTtlMs":)" << snapshot->cacheTtl.count()
+                    << R"(,"titleChanges":)" << snapshot->titleChanges.received
+                    << R"(,"titleChangesDelivered":)" << snapshot->titleChanges.delivered
+                    << R"(,"coalescingRatio":)" << snapshot->titleChanges.ratio();
+                oss << R"(,"visibleWindows":)" << snapshot->stateCounts.visible
+                    << R"(,"minimizedWindows":)" << snapshot->stateCounts.minimized
+                    << R"(,"focusedWindows":)" << snapshot->stateCounts.focused;
+                if (snapshot->workspaceBuckets) {
+                    oss << R"(,"windowsByWorkspace":{)";
+                    bool first = true;
+                    for (const auto& [workspaceId, handles] : snapshot->workspaceBuckets->handles) {
+                        oss << (first ? "" : ",") << "\"" << escapeJson(workspaceId) << "\":" << handles->size();
+                        first = false;
+                    }
+                    oss << "}";
+                }
+                if (statsProvider_) {
+                    std::string extra = statsProvider_();
+                    if (!extra.empty()) {
+                        oss << "," << extra;
+                    }
+                }
+                oss << "}";
+                reply({oss.str(), true});
+                return;
+            }
+
+            std::vector<const WindowInfo*> matches;
+            matches.reserve(snapshot->windows.size());
+            uint64_t etag = snapshot->etag;
+            if (command == "search") {
+                if (argument.empty()) {
+                    reply({formatError(command, "search requires a keyword"), false});
+                    return;
+                }
+                SearchQuery query(argument);
+                etag = EMPTY_ETAG;
+                for (const auto& window : snapshot->windows) {
+                    if (query.matches(window)) {
+                        matches.push_back(&window);
+                        etag = appendEtag(etag, window);
+                    }
+                }
+            } else {
+                for (const auto& window : snapshot->windows) {
+                    matches.push_back(&window);
+                }
+            }
+
+            // Conditional request: skip serializing a result the client already has
+            if (ifChanged && *ifChanged == formatEtag(etag)) {
+                reply({R"({"ok":true,"command":")" + command + R"(","notModified":true,"generation":)" +
+                           std::to_string(snapshot->generation) + R"(,"etag":")" + formatEtag(etag) + "\"}",
+                       true});
+                return;
+            }
+
+            reply({formatWindowList(command, *snapshot, matches, etag), true});
+            return;
+        }
+
+        if (command == "changes") {
+            char* end = nullptr;
+            unsigned long long since = std::strtoull(argument.c_str(), &end, 10);
+            if (argument.empty() || *end != '\0') {
+                reply({formatError(command, "changes requires a generation number"), false});
+                return;
+            }
+            auto snapshot = snapshots_();
+            if (!snapshot) {
+                reply({formatError(command, "no window snapshot available yet"), false});
+                return;
+            }
+            reply({formatDelta(windowManager_.getChangesSince(since, *snapshot)), true});
+            return;
+        }
+
+        if (command == "focus" || command == "validate") {
+            if (argument.empty()) {
+                reply({formatError(command, command + " requires a window handle"), false});
+                return;
+            }
+
+            auto snapshot = snapshots_();
+            executor_([this, command, argument, snapshot]() {
+                std::ostringstream oss;
+                bool ok = true;
+                if (command == "focus") {
+                    // Snapshot hit: skip re-validation, the handle was seen moments ago
+                    const WindowInfo* window = snapshot ? snapshot->findWindow(argument) : nullptr;
+                    ok = window ? windowManager_.focusWindowFromSnapshot(*window)
+                                : windowManager_.focusWindowByHandle(argument);
+                    oss << R"({"ok":)" << (ok ? "true" : "false")
+                        << R"(,"command":"focus","handle":")" << escapeJson(argument) << "\"}";
+                } else {
+                    bool valid = windowManager_.validateHandle(argument);
+                    oss << R"({"ok":true,"command":"validate","handle":")" << escapeJson(argument)
+                        << R"(","valid":)" << (valid ? "true" : "false") << "}";
+                }
+                return Response{oss.str(), ok};
+            }, reply);
+            return;
+        }
+
+        if (command == "refresh") {
+            executor_([this]() {
+                bool refreshed = windowManager_.refreshWindows();
+                auto snapshot = windowManager_.getLatestSnapshot();
+                std::ostringstream oss;
+                oss << R"({"ok":)" << (refreshed ? "true" : "false")
+                    << R"(,"command":"refresh","generation":)" << (snapshot ? snapshot->generation : 0) << "}";
+                return Response{oss.str(), refreshed};
+            }, reply);
+            return;
+        }
+
+        reply({formatError(command, "unknown command"), false});
+
+    } catch (const std::exception& e) {
+        reply({formatError(command, e.what()), false});
+    }
+}
+
+std::string RequestHandler::formatWindowList(const std::string& command, const WindowSnapshot& snapshot,
+                                             const std::vector<const WindowInfo*>& windows, uint64_t etag) const {
+    std::string json;
+    json.reserve(96 + windows.size() * 256);
+    json += R"({"ok":true,"command":")" + command + R"(","generation":)" + std::to_string(snapshot.generation);
+    json += R"(,"etag":")" + formatEtag(etag) + "\"";
+    json += R"(,"ageMs":)" + std::to_string(snapshot.age().count());
+    json += R"(,"count":)" + std::to_string(windows.size()) + R"(,"windows":[)";
+    for (size_t i = 0; i < windows.size(); ++i) {
+        if (i > 0) {
+            json += ',';
+        }
+        json += formatWindow(*windows[i]);
+    }
+    json += "]}";
+    return json;
+}
+
+std::string RequestHandler::formatDelta(const WindowDelta& delta) {
+    std::string json;
+    json.reserve(96 + (delta.added.size() + delta.modified.size()) * 256 + delta.removed.size() * 16);
+    json += R"({"ok":true,"command":"changes","since":)" + std::to_string(delta.fromGeneration);
+    json += R"(,"generation":)" + std::to_string(delta.toGeneration);
+    json += R"(,"full":)";
+    json += delta.fullSnapshot ? "true" : "false";
+
+    json += R"(,"added":[)";
+    for (size_t i = 0; i < delta.added.size(); ++i) {
+        json += (i > 0 ? "," : "") + formatWindow(delta.added[i]);
+    }
+    json += R"(],"removed":[)";
+    for (size_t i = 0; i < delta.removed.size(); ++i) {
+        json += (i > 0 ? ",\"" : "\"") + escapeJson(delta.removed[i]) + "\"";
+    }
+    json += R"(],"modified":[)";
+    for (size_t i = 0; i < delta.modified.size(); ++i) {
+        json += i > 0 ? R"(,{"fields":[)" : R"({"fields":[)";
+        auto names = windowFieldNames(delta.modified[i].changedFields);
+        for (size_t j = 0; j < names.size(); ++j) {
+            json += (j > 0 ? ",\"" : "\"") + names[j] + "\"";
+        }
+        json += R"(],"window":)" + formatWindow(delta.modified[i].window) + "}";
+    }
+    json += "]}";
+    return json;
+}
+
+std::string RequestHandler::escapeJson(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+                    escaped += buffer;
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+std::optional<std::string> RequestHandler::parseJsonRequest(const std::string& json) {
+    // Flat object with string values only: {"command":"focus","argument":"0x3a00004"}
+    size_t position = 0;
+    auto skipWhitespace = [&]() {
+        while (position < json.size() && std::isspace(static_cast<unsigned char>(json[position]))) {
+            ++position;
+        }
+    };
+    auto parseString = [&]() -> std::optional<std::string> {
+        if (position >= json.size() || json[position] != '"') {
+            return std::nullopt;
+        }
+        std::string value;
+        for (++position; position < json.size(); ++position) {
+            char c = json[position];
+            if (c == '"') {
+                ++position;
+                return value;
+            }
+            if (c != '\\') {
+                value += c;
+                continue;
+            }
+            if (++position >= json.size()) {
+                return std::nullopt;
+            }
+            switch (json[position]) {
+                case 'n': value += '\n'; break;
+                case 't': value += '\t'; break;
+                case 'r': value += '\r'; break;
+                case 'u': {
+                    if (position + 4 >= json.size()) {
+                        return std::nullopt;
+                    }
+                    unsigned long code = std::strtoul(json.substr(position + 1, 4).c_str(), nullptr, 16);
+                    value += code < 0x80 ? static_cast<char>(code) : '?';
+                    position += 4;
+                    break;
+                }
+                default: value += json[position]; break;
+            }
+        }
+        return std::nullopt;
+    };
+
+    std::string command;
+    std::string argument;
+    std::string ifChanged;
+
+    skipWhitespace();
+    if (position >= json.size() || json[position++] != '{') {
+        return std::nullopt;
+    }
+    skipWhitespace();
+    while (position < json.size() && json[position] != '}') {
+        auto key = parseString();
+        skipWhitespace();
+        if (!key || position >= json.size() || json[position++] != ':') {
+            return std::nullopt;
+        }
+        skipWhitespace();
+        auto value = parseString();
+        if (!value) {
+            return std::nullopt;
+        }
+
+        if (*key == "command") {
+            command = *value;
+        } else if (*key == "argument" || *key == "query" || *key == "handle" || *key == "since") {
+            argument = *value;
+        } else if (*key == "ifChanged") {
+            ifChanged = *value;
+        }
+
+        skipWhitespace();
+        if (position < json.size() && json[position] == ',') {
+            ++position;
+            skipWhitespace();
+        }
+    }
+    if (position >= json.size() || command.empty()) {
+        return std::nullopt;
+    }
+
+    std::string request = argument.empty() ? command : command + " " + argument;
+    if (!ifChanged.empty()) {
+        request += " --if-changed " + ifChanged;
+    }
+    return request;
+}
+
+std::optional<std::string> RequestHandler::takeOption(std::string& argument, const std::string& option) {
+    // "<option> <value>" at the start or after a space; removed from the argument
+    const std::string token = option + " ";
+    size_t position = argument.find(token);
+    while (position != std::string::npos && position > 0 && argument[position - 1] != ' ') {
+        position = argument.find(token, position + 1);
+    }
+    if (position == std::string::npos) {
+        return std::nullopt;
+    }
+
+    size_t valueStart = position + token.size();
+    size_t valueEnd = argument.find(' ', valueStart);
+    std::string value = argument.substr(valueStart, valueEnd == std::string::npos ? std::string::npos
+                                                                                   : valueEnd - valueStart);
+    argument.erase(position, valueEnd == std::string::npos ? std::string::npos : valueEnd + 1 - position);
+    while (!argument.empty() && argument.back() == ' ') {
+        argument.pop_back();
+    }
+    return value;
+}
+
+std::string RequestHandler::formatWindow(const WindowInfo& window) {
+    std::ostringstream oss;
+    oss << R"({"handle":")" << escapeJson(window.handle)
+        << R"(","title":")" << escapeJson(window.title)
+        << R"(","owner":")" << escapeJson(window.ownerName)
+        << R"(","pid":)" << window.processId
+        << R"(,"x":)" << window.x << R"(,"y":)" << window.y
+        << R"(,"width":)" << window.width << R"(,"height":)" << window.height
+        << R"(,"visible":)" << (window.isVisible ? "true" : "false")
+        << R"(,"workspace":")" << escapeJson(window.workspaceId)
+        << R"(","focused":)" << (window.isFocused ? "true" : "false")
+        << R"(,"etag":")" << formatEtag(window.contentVersion != 0 ? window.contentVersion
+                                                                  : window.computeContentVersion()) << "\"}";
+    return oss.str();
+}
+
+std::string RequestHandler::formatError(const std::string& command, const std::string& message) {
+    return R"({"ok":false,"command":")" + escapeJson(command) + R"(","error":")" + escapeJson(message) + "\"}";
+}
+
+} // namespace WindowManager
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../core/window_manager.hpp"
+#include "../core/window_snapshot.hpp"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace WindowManager {
+
+/**
+ * Line protocol shared by the daemon and batch mode
+ * One request per line, one JSON object per response line:
+ *   ping | list | search <keyword> | changes <generation> | focus <handle> | validate <handle>
+ *   | refresh | stats
+ * A request may also be a flat JSON object: {"command":"search","argument":"chrome"}
+ * list and search accept "--if-changed <etag>" (JSON: "ifChanged"); when the result
+ * still has that etag the reply is a short {"notModified":true,...} line.
+ * Queries are answered from the current snapshot; requests that need the display
+ * server are handed to the X executor, which decides where and when they run.
+ */
+class RequestHandler {
+public:
+    struct Response {
+        std::string line; // One JSON object, without the newline
+        bool ok = true;   // Mirrors the "ok" field, so callers never parse the line
+    };
+
+    using Reply = std::function<void(Response)>;
+    using SnapshotProvider = std::function<std::shared_ptr<const WindowSnapshot>()>;
+    using XTask = std::function<Response()>;
+    using XExecutor = std::function<void(XTask, Reply)>;
+    using StatsProvider = std::function<std::string()>;         // Extra "key":value pairs for stats
+
+    RequestHandler(WindowManager& windowManager, SnapshotProvider snapshots, XExecutor executor);
+
+    // Reply is invoked exactly once per request, possibly later and from another thread
+    void handle(const std::string& line, Reply reply);
+
+    void setStatsProvider(StatsProvider provider);
+
+    // JSON helpers (single line, escaped)
+    static std::string escapeJson(const std::string& text);
+    static std::optional<std::string> parseJsonRequest(const std::string& json); // -> "command argument"
+    static std::optional<std::string> takeOption(std::string& argument, const std::string& option);
+    static std::string formatWindow(const WindowInfo& window);
+    static std::string formatDelta(const WindowDelta& delta);
+    static std::string formatError(const std::string& command, const std::string& message);
+
+private:
+    WindowManager& windowManager_;
+    SnapshotProvider snapshots_;
+    XExecutor executor_;
+    StatsProvider statsProvider_;
+
+    std::string formatWindowList(const std::string& command, const WindowSnapshot& snapshot,
+                                 const std::vector<const WindowInfo*>& windows, uint64_t etag) const;
+};
+
+} // namespace WindowManager
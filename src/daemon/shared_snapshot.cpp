@@ -0,0 +1,276 @@
+#include "shared_snapshot.hpp"
+#include "../core/exceptions.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace WindowManager {
+
+namespace {
+
+uint8_t packFlags(const WindowInfo& window) {
+    uint8_t flags = 0;
+    if (window.isVisible) flags |= SHARED_WINDOW_VISIBLE;
+    if (window.isFocused) flags |= SHARED_WINDOW_FOCUSED;
+    if (window.isOnCurrentWorkspace) flags |= SHARED_WINDOW_ON_CURRENT_WORKSPACE;
+    if (window.isMinimized) flags |= SHARED_WINDOW_MINIMIZED;
+    return flags;
+}
+
+// Strings longer than a record length field can describe are cut
+uint16_t clampLength(size_t length) {
+    return static_cast<uint16_t>(std::min<size_t>(length, UINT16_MAX));
+}
+
+size_t recordSize(const WindowInfo& window) {
+    return sizeof(SharedWindowRecord) + clampLength(window.handle.size()) + clampLength(window.title.size()) +
+           clampLength(window.ownerName.size()) + clampLength(window.workspaceId.size());
+}
+
+char* payloadOf(SharedSnapshotHeader* header) {
+    return reinterpret_cast<char*>(header) + sizeof(SharedSnapshotHeader);
+}
+
+const char* payloadOf(const SharedSnapshotHeader* header) {
+    return reinterpret_cast<const char*>(header) + sizeof(SharedSnapshotHeader);
+}
+
+} // namespace
+
+std::string defaultSharedSnapshotName() {
+    return "/window-manager-" + std::to_string(getuid());
+}
+
+// SnapshotPublisher
+
+SnapshotPublisher::SnapshotPublisher(std::string name, size_t capacity)
+    : name_(std::move(name))
+    , mappingSize_(sizeof(SharedSnapshotHeader) + capacity)
+    , header_(nullptr) {
+
+    int fd = shm_open(name_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        throw PlatformApiException("shm_open", errno, std::strerror(errno));
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(mappingSize_)) < 0) {
+        int error = errno;
+        close(fd);
+        shm_unlink(name_.c_str());
+        throw PlatformApiException("ftruncate", error, std::strerror(error));
+    }
+
+    void* mapping = mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name_.c_str());
+        throw PlatformApiException("mmap", error, std::strerror(error));
+    }
+
+    // A segment left behind by a crashed daemon is simply reinitialized
+    header_ = new (mapping) SharedSnapshotHeader{};
+    header_->version = SharedSnapshotHeader::VERSION;
+    header_->capacity = capacity;
+    header_->writerPid = static_cast<uint32_t>(getpid());
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = SharedSnapshotHeader::MAGIC;
+}
+
+SnapshotPublisher::~SnapshotPublisher() {
+    if (header_) {
+        munmap(header_, mappingSize_);
+        shm_unlink(name_.c_str());
+    }
+}
+
+void SnapshotPublisher::publish(const WindowSnapshot& snapshot) {
+    uint64_t sequence = header_->sequence.load(std::memory_order_relaxed);
+    header_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    char* cursor = payloadOf(header_);
+    size_t used = 0;
+    uint32_t count = 0;
+    for (const auto& window : snapshot.windows) {
+        size_t size = recordSize(window);
+        if (used + size > header_->capacity) {
+            break;
+        }
+
+        SharedWindowRecord record{};
+        record.x = window.x;
+        record.y = window.y;
+        record.width = window.width;
+        record.height = window.height;
+        record.processId = window.processId;
+        record.handleLength = clampLength(window.handle.size());
+        record.titleLength = clampLength(window.title.size());
+        record.ownerLength = clampLength(window.ownerName.size());
+        record.workspaceLength = clampLength(window.workspaceId.size());
+        record.flags = packFlags(window);
+
+        std::memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+        std::memcpy(cursor, window.handle.data(), record.handleLength);
+        cursor += record.handleLength;
+        std::memcpy(cursor, window.title.data(), record.titleLength);
+        cursor += record.titleLength;
+        std::memcpy(cursor, window.ownerName.data(), record.ownerLength);
+        cursor += record.ownerLength;
+        std::memcpy(cursor, window.workspaceId.data(), record.workspaceLength);
+        cursor += record.workspaceLength;
+
+        used += size;
+        ++count;
+    }
+
+    // Translate the steady capture time into wall-clock time for other processes
+    auto age = std::chrono::steady_clock::now() - snapshot.capturedAt;
+    auto publishedAt = std::chrono::system_clock::now() - age;
+
+    header_->generation = snapshot.generation;
+    header_->publishedAtNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        publishedAt.time_since_epoch()).count();
+    header_->windowCount = count;
+    header_->payloadSize = static_cast<uint32_t>(used);
+
+    header_->sequence.store(sequence + 2, std::memory_order_release);
+    publishedGeneration_ = snapshot.generation;
+}
+
+// SnapshotReader
+
+SnapshotReader::SnapshotReader(const std::string& name)
+    : mappingSize_(0)
+    , header_(nullptr) {
+
+    int fd = shm_open(name.c_str(), O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        throw PlatformApiException("shm_open", errno, std::strerror(errno));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(SharedSnapshotHeader)) {
+        close(fd);
+        throw PlatformApiException("fstat", EINVAL, "shared snapshot segment is missing or too small");
+    }
+    mappingSize_ = static_cast<size_t>(info.st_size);
+
+    void* mapping = mmap(nullptr, mappingSize_, PROT_READ, MAP_SHARED, fd, 0);
+    int error = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw PlatformApiException("mmap", error, std::strerror(error));
+    }
+    header_ = static_cast<const SharedSnapshotHeader*>(mapping);
+
+    if (header_->magic != SharedSnapshotHeader::MAGIC || header_->version != SharedSnapshotHeader::VERSION ||
+        sizeof(SharedSnapshotHeader) + header_->capacity > mappingSize_) {
+        munmap(mapping, mappingSize_);
+        header_ = nullptr;
+        throw PlatformApiException("mmap", EPROTO, "shared snapshot segment has an unknown layout");
+    }
+}
+
+SnapshotReader::~SnapshotReader() {
+    if (header_) {
+        munmap(const_cast<SharedSnapshotHeader*>(header_), mappingSize_);
+    }
+}
+
+std::optional<uint64_t> SnapshotReader::getGeneration(unsigned int maxRetries) const {
+    for (unsigned int attempt = 0; attempt <= maxRetries; ++attempt) {
+        uint64_t before = header_->sequence.load(std::memory_order_acquire);
+        uint64_t generation = header_->generation;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((before & 1) == 0 && header_->sequence.load(std::memory_order_relaxed) == before) {
+            return generation;
+        }
+    }
+    return std::nullopt;
+}
+
+uint32_t SnapshotReader::getWriterPid() const {
+    return header_->writerPid;
+}
+
+std::optional<WindowSnapshot> SnapshotReader::read(unsigned int maxRetries) const {
+    for (unsigned int attempt = 0; attempt <= maxRetries; ++attempt) {
+        uint64_t before = header_->sequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            continue; // Writer in progress
+        }
+
+        uint64_t generation = header_->generation;
+        int64_t publishedAtNs = header_->publishedAtNs;
+        uint32_t windowCount = header_->windowCount;
+        size_t payloadSize = std::min<size_t>(header_->payloadSize, header_->capacity);
+        buffer_.assign(payloadOf(header_), payloadSize);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header_->sequence.load(std::memory_order_relaxed) != before) {
+            continue; // Torn copy
+        }
+
+        // The copy is consistent; decode it at leisure
+        WindowSnapshot snapshot;
+        snapshot.generation = generation;
+        auto age = std::chrono::system_clock::now() -
+                   std::chrono::system_clock::time_point(std::chrono::nanoseconds(publishedAtNs));
+        snapshot.capturedAt = std::chrono::steady_clock::now() -
+                              std::chrono::duration_cast<std::chrono::steady_clock::duration>(age);
+        snapshot.windows.reserve(windowCount);
+
+        const char* cursor = buffer_.data();
+        const char* end = cursor + buffer_.size();
+        for (uint32_t i = 0; i < windowCount && cursor + sizeof(SharedWindowRecord) <= end; ++i) {
+            SharedWindowRecord record;
+            std::memcpy(&record, cursor, sizeof(record));
+            cursor += sizeof(record);
+
+            size_t strings = static_cast<size_t>(record.handleLength) + record.titleLength +
+                             record.ownerLength + record.workspaceLength;
+            if (cursor + strings > end) {
+                break;
+            }
+
+            WindowInfo window;
+            window.x = record.x;
+            window.y = record.y;
+            window.width = record.width;
+            window.height = record.height;
+            window.processId = record.processId;
+            window.isVisible = (record.flags & SHARED_WINDOW_VISIBLE) != 0;
+            window.isFocused = (record.flags & SHARED_WINDOW_FOCUSED) != 0;
+            window.isOnCurrentWorkspace = (record.flags & SHARED_WINDOW_ON_CURRENT_WORKSPACE) != 0;
+            window.isMinimized = (record.flags & SHARED_WINDOW_MINIMIZED) != 0;
+            window.handle.assign(cursor, record.handleLength);
+            cursor += record.handleLength;
+            window.title.assign(cursor, record.titleLength);
+            cursor += record.titleLength;
+            window.ownerName.assign(cursor, record.ownerLength);
+            cursor += record.ownerLength;
+            window.workspaceId.assign(cursor, record.workspaceLength);
+            cursor += record.workspaceLength;
+
+            snapshot.windows.push_back(std::move(window));
+        }
+
+        return snapshot;
+    }
+
+    return std::nullopt;
+}
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
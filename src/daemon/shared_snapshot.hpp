@@ -0,0 +1,133 @@
+#pragma once
+
+#include "platform_config.h"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include "../core/window_snapshot.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace WindowManager {
+
+/**
+ * Shared-memory layout of a published window snapshot
+ * Single writer (the daemon), any number of readers. Readers use a seqlock:
+ * `sequence` is odd while the writer is updating, so a reader copies the
+ * payload and retries if the sequence changed underneath it.
+ *
+ * Payload: windowCount records, each a SharedWindowRecord followed by the
+ * handle, title, owner and workspace id bytes (no terminators).
+ */
+struct SharedSnapshotHeader {
+    static constexpr uint32_t MAGIC{0x574D5348}; // "WMSH"
+    static constexpr uint32_t VERSION{1};
+
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint64_t> sequence;
+    uint64_t generation;
+    int64_t publishedAtNs;     // system_clock, comparable across processes
+    uint64_t capacity;         // Payload bytes available after the header
+    uint32_t windowCount;
+    uint32_t payloadSize;
+    uint32_t writerPid;
+    uint32_t reserved;
+};
+
+struct SharedWindowRecord {
+    int32_t x;
+    int32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t processId;
+    uint16_t handleLength;
+    uint16_t titleLength;
+    uint16_t ownerLength;
+    uint16_t workspaceLength;
+    uint8_t flags;             // SharedWindowFlags
+    uint8_t reserved[3];
+};
+
+enum SharedWindowFlags : uint8_t {
+    SHARED_WINDOW_VISIBLE = 1 << 0,
+    SHARED_WINDOW_FOCUSED = 1 << 1,
+    SHARED_WINDOW_ON_CURRENT_WORKSPACE = 1 << 2,
+    SHARED_WINDOW_MINIMIZED = 1 << 3,
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock counter must be lock-free to live in shared memory");
+
+// "/window-manager-<uid>"
+std::string defaultSharedSnapshotName();
+
+/**
+ * Publishes snapshots into a POSIX shared-memory segment
+ * The segment is created on construction and unlinked on destruction.
+ * Windows that do not fit into the capacity are left out of the published copy.
+ */
+class SnapshotPublisher {
+public:
+    static constexpr size_t DEFAULT_CAPACITY{4 * 1024 * 1024}; // Sparse; only touched pages are backed
+
+    explicit SnapshotPublisher(std::string name = defaultSharedSnapshotName(), size_t capacity = DEFAULT_CAPACITY);
+    ~SnapshotPublisher();
+
+    // Non-copyable, non-moveable (owns the mapping)
+    SnapshotPublisher(const SnapshotPublisher&) = delete;
+    SnapshotPublisher& operator=(const SnapshotPublisher&) = delete;
+    SnapshotPublisher(SnapshotPublisher&&) = delete;
+    SnapshotPublisher& operator=(SnapshotPublisher&&) = delete;
+
+    // Must be called from one thread at a time
+    void publish(const WindowSnapshot& snapshot);
+
+    uint64_t getPublishedGeneration() const { return publishedGeneration_; }
+    const std::string& getName() const { return name_; }
+
+private:
+    std::string name_;
+    size_t mappingSize_;
+    SharedSnapshotHeader* header_;
+    uint64_t publishedGeneration_ = 0;
+};
+
+/**
+ * Reads snapshots published by SnapshotPublisher
+ * After construction (shm_open + mmap) reads involve no system calls.
+ */
+class SnapshotReader {
+public:
+    static constexpr unsigned int DEFAULT_MAX_RETRIES{64};
+
+    // Throws PlatformApiException when no daemon has published under this name
+    explicit SnapshotReader(const std::string& name = defaultSharedSnapshotName());
+    ~SnapshotReader();
+
+    // Non-copyable, non-moveable (owns the mapping)
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+    SnapshotReader(SnapshotReader&&) = delete;
+    SnapshotReader& operator=(SnapshotReader&&) = delete;
+
+    // Consistent copy of the current snapshot; nullopt if the writer kept racing us
+    std::optional<WindowSnapshot> read(unsigned int maxRetries = DEFAULT_MAX_RETRIES) const;
+
+    // Cheap change check for pollers: compare before calling read(). Bounded like
+    // read(), so a writer that died mid-publish yields nullopt instead of a hang.
+    std::optional<uint64_t> getGeneration(unsigned int maxRetries = DEFAULT_MAX_RETRIES) const;
+
+    uint32_t getWriterPid() const;
+
+private:
+    size_t mappingSize_;
+    const SharedSnapshotHeader* header_;
+    mutable std::string buffer_; // Reused payload copy
+};
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
@@ -0,0 +1,64 @@
+#include "task_worker.hpp"
+
+namespace WindowManager {
+
+TaskWorker::TaskWorker() {
+    worker_ = std::thread(&TaskWorker::workerLoop, this);
+}
+
+TaskWorker::~TaskWorker() {
+    stop();
+}
+
+void TaskWorker::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+size_t TaskWorker::getQueueDepth() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+void TaskWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        tasks_.clear();
+    }
+    condition_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void TaskWorker::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+        if (stopping_) {
+            break;
+        }
+
+        Task task = std::move(tasks_.front());
+        tasks_.pop_front();
+
+        lock.unlock();
+        try {
+            task();
+        } catch (const std::exception&) {
+            // Tasks report their own failures; the worker keeps serving the queue
+        }
+        lock.lock();
+    }
+}
+
+} // namespace WindowManager
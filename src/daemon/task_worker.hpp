@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace WindowManager {
+
+/**
+ * Single-thread FIFO task queue
+ * Used as the "X owner": every request that talks to the display server runs
+ * here, one at a time, so the event loop never blocks on a round trip
+ */
+class TaskWorker {
+public:
+    using Task = std::function<void()>;
+
+    TaskWorker();
+    ~TaskWorker();
+
+    // Non-copyable, non-moveable (owns the worker thread)
+    TaskWorker(const TaskWorker&) = delete;
+    TaskWorker& operator=(const TaskWorker&) = delete;
+    TaskWorker(TaskWorker&&) = delete;
+    TaskWorker& operator=(TaskWorker&&) = delete;
+
+    void submit(Task task);
+    size_t getQueueDepth() const;
+
+    // Finishes the task in progress; queued tasks are discarded
+    void stop();
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Task> tasks_;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    void workerLoop();
+};
+
+} // namespace WindowManager
@@ -0,0 +1,424 @@
+#include "window_service.hpp"
+#include "../core/exceptions.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace WindowManager {
+
+WindowService::WindowService(std::unique_ptr<WindowManager> windowManager, std::string socketPath,
+                             std::string sharedSnapshotName)
+    : windowManager_(std::move(windowManager))
+    , socketPath_(socketPath.empty() ? defaultSocketPath() : std::move(socketPath))
+    , sharedSnapshotName_(std::move(sharedSnapshotName)) {
+
+    if (!windowManager_) {
+        throw ConfigurationException("windowManager", "WindowService requires a window manager");
+    }
+
+    // X owner tasks that read the window list should not stall the queue on an expired cache
+    windowManager_->setStaleWhileRevalidate(true);
+}
+
+WindowService::~WindowService() {
+    if (xOwner_) {
+        xOwner_->stop();
+    }
+    for (auto& entry : clients_) {
+        close(entry.second.fd);
+    }
+    clients_.clear();
+    if (signalFd_ >= 0) {
+        close(signalFd_);
+    }
+    closeListenSocket();
+}
+
+std::string WindowService::defaultSocketPath() {
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    if (runtimeDir && *runtimeDir) {
+        return std::string(runtimeDir) + "/window-manager.sock";
+    }
+    return "/tmp/window-manager-" + std::to_string(getuid()) + ".sock";
+}
+
+void WindowService::stop() {
+    loop_.stop();
+}
+
+void WindowService::run() {
+    // Signals are consumed through a signalfd; block them before any thread is started
+    // so that no worker thread receives them instead
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigset_t previousMask;
+    pthread_sigmask(SIG_BLOCK, &signals, &previousMask);
+
+    signalFd_ = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signalFd_ < 0) {
+        throw PlatformApiException("signalfd", errno, std::strerror(errno));
+    }
+    loop_.addFd(signalFd_, EPOLLIN, [this](uint32_t) {
+        signalfd_siginfo info;
+        while (read(signalFd_, &info, sizeof(info)) > 0) {
+        }
+        loop_.stop();
+    });
+
+    xOwner_ = std::make_unique<TaskWorker>();
+    handler_ = std::make_unique<RequestHandler>(
+        *windowManager_,
+        [this]() { return windowManager_->getLatestSnapshot(); },
+        [this](RequestHandler::XTask task, RequestHandler::Reply reply) {
+            xOwner_->submit([this, task = std::move(task), reply = std::move(reply)]() {
+                RequestHandler::Response response;
+                try {
+                    response = task();
+                } catch (const std::exception& e) {
+                    response = {RequestHandler::formatError("", e.what()), false};
+                }
+                publishLatestSnapshot(); // A refresh request may have produced a new snapshot
+                // Client state belongs to the loop thread
+                loop_.post([reply, response = std::move(response)]() mutable { reply(std::move(response)); });
+            });
+        });
+    handler_->setStatsProvider([this]() {
+        return "\"clients\":" + std::to_string(clients_.size()) +
+               ",\"xQueueDepth\":" + std::to_string(xOwner_->getQueueDepth());
+    });
+
+    // Initial snapshot before accepting clients, so queries never see an empty service
+    windowManager_->getSnapshot();
+
+    openListenSocket();
+
+    if (!sharedSnapshotName_.empty()) {
+        publisher_ = std::make_unique<SnapshotPublisher>(sharedSnapshotName_);
+        publishLatestSnapshot();
+    }
+
+    int changeFd = windowManager_->getChangeNotificationFd();
+    if (changeFd >= 0) {
+        loop_.addFd(changeFd, EPOLLIN, [this](uint32_t) { onChangeNotification(); });
+        // Watches registered by the initial enumeration are applied here
+        windowManager_->processChangeNotifications();
+    }
+
+    // Notifications can be missed (or be unsupported): reconcile periodically
+    loop_.addTimer(changeFd >= 0 ? RECONCILE_INTERVAL : POLL_INTERVAL, true,
+                   [this]() { scheduleRefresh(); });
+
+    loop_.run();
+
+    xOwner_->stop();
+    publisher_.reset();
+    pthread_sigmask(SIG_SETMASK, &previousMask, nullptr);
+}
+
+// Listening socket
+
+void WindowService::openListenSocket() {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath_.size() >= sizeof(address.sun_path)) {
+        throw ConfigurationException("socket", "path is too long: " + socketPath_);
+    }
+    std::memcpy(address.sun_path, socketPath_.c_str(), socketPath_.size() + 1);
+
+    listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        throw PlatformApiException("socket", errno, std::strerror(errno));
+    }
+
+    // A leftover socket file is removed, a live one means another daemon is running
+    struct stat existing;
+    if (lstat(socketPath_.c_str(), &existing) == 0) {
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool inUse = probe >= 0 &&
+                     connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        if (probe >= 0) {
+            close(probe);
+        }
+        if (inUse) {
+            close(listenFd_);
+            listenFd_ = -1;
+            throw ConfigurationException("socket", "another daemon is already listening on " + socketPath_);
+        }
+        if (!S_ISSOCK(existing.st_mode)) {
+            close(listenFd_);
+            listenFd_ = -1;
+            throw ConfigurationException("socket", socketPath_ + " exists and is not a socket");
+        }
+        unlink(socketPath_.c_str());
+    }
+
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        int error = errno;
+        close(listenFd_);
+        listenFd_ = -1;
+        throw PlatformApiException("bind", error, std::strerror(error));
+    }
+    chmod(socketPath_.c_str(), S_IRUSR | S_IWUSR);
+
+    if (listen(listenFd_, SOMAXCONN) < 0) {
+        int error = errno;
+        closeListenSocket();
+        throw PlatformApiException("listen", error, std::strerror(error));
+    }
+
+    loop_.addFd(listenFd_, EPOLLIN, [this](uint32_t) { acceptClients(); });
+}
+
+void WindowService::closeListenSocket() {
+    if (listenFd_ < 0) {
+        return;
+    }
+    close(listenFd_);
+    listenFd_ = -1;
+    unlink(socketPath_.c_str());
+}
+
+void WindowService::acceptClients() {
+    while (true) {
+        int fd = accept4(listenFd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            return; // EAGAIN, or out of descriptors: retry on the next readiness event
+        }
+
+        uint64_t clientId = nextClientId_++;
+        Client& client = clients_[clientId];
+        client.fd = fd;
+        loop_.addFd(fd, EPOLLIN | EPOLLRDHUP, [this, clientId](uint32_t events) {
+            onClientEvent(clientId, events);
+        });
+    }
+}
+
+// Clients
+
+void WindowService::onClientEvent(uint64_t clientId, uint32_t events) {
+    auto it = clients_.find(clientId);
+    if (it == clients_.end()) {
+        return;
+    }
+    Client& client = it->second;
+    activeClientId_ = clientId;
+
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        client.closing = true;
+    } else {
+        if (events & EPOLLOUT) {
+            flushClient(client);
+        }
+        if (events & (EPOLLIN | EPOLLRDHUP)) {
+            readClient(clientId, client);
+        }
+    }
+
+    activeClientId_ = 0;
+    if (client.closing) {
+        closeClient(clientId);
+    }
+}
+
+void WindowService::readClient(uint64_t clientId, Client& client) {
+    char buffer[4096];
+    while (!client.closing) {
+        ssize_t received = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            client.input.append(buffer, static_cast<size_t>(received));
+            processLines(clientId, client);
+            continue;
+        }
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return;
+        }
+        // Orderly shutdown or error; replies still in flight are discarded
+        client.closing = true;
+    }
+}
+
+void WindowService::processLines(uint64_t clientId, Client& client) {
+    size_t start = 0;
+    size_t newline;
+    while (!client.closing && (newline = client.input.find('\n', start)) != std::string::npos) {
+        std::string line = client.input.substr(start, newline - start);
+        start = newline + 1;
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+
+        uint64_t slot = client.firstReplySlot + client.replies.size();
+        client.replies.emplace_back();
+
+        // Snapshot queries reply immediately; X requests reply later via loop_.post()
+        handler_->handle(line, [this, clientId, slot](RequestHandler::Response response) {
+            deliverReply(clientId, slot, std::move(response.line));
+        });
+    }
+    client.input.erase(0, start);
+
+    if (client.input.size() > MAX_REQUEST_LENGTH) {
+        client.closing = true;
+    }
+}
+
+void WindowService::deliverReply(uint64_t clientId, uint64_t slot, std::string response) {
+    auto it = clients_.find(clientId);
+    if (it == clients_.end()) {
+        return; // Client went away while the request was queued
+    }
+    Client& client = it->second;
+
+    client.replies[slot - client.firstReplySlot] = std::move(response);
+    while (!client.replies.empty() && client.replies.front()) {
+        client.output += *client.replies.front();
+        client.output += '\n';
+        client.replies.pop_front();
+        ++client.firstReplySlot;
+    }
+    flushClient(client);
+
+    // Synchronous replies arrive while onClientEvent still uses the client; it closes it itself
+    if (client.closing && clientId != activeClientId_) {
+        closeClient(clientId);
+    }
+}
+
+void WindowService::flushClient(Client& client) {
+    while (!client.output.empty()) {
+        ssize_t sent = send(client.fd, client.output.data(), client.output.size(), MSG_NOSIGNAL);
+        if (sent > 0) {
+            client.output.erase(0, static_cast<size_t>(sent));
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        client.closing = true;
+        return;
+    }
+
+    if (client.output.size() > MAX_PENDING_OUTPUT) {
+        client.closing = true;
+        return;
+    }
+
+    bool wantsWrite = !client.output.empty();
+    if (wantsWrite != client.wantsWrite) {
+        client.wantsWrite = wantsWrite;
+        loop_.modifyFd(client.fd, EPOLLIN | EPOLLRDHUP | (wantsWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u));
+    }
+}
+
+void WindowService::closeClient(uint64_t clientId) {
+    auto it = clients_.find(clientId);
+    if (it == clients_.end()) {
+        return;
+    }
+    loop_.removeFd(it->second.fd);
+    close(it->second.fd);
+    clients_.erase(it);
+}
+
+// Snapshot maintenance
+
+void WindowService::onChangeNotification() {
+    try {
+        if (windowManager_->processChangeNotifications()) {
+            scheduleRefresh();
+        }
+        armCoalesceTimer();
+    } catch (const WindowManagerException&) {
+        // The periodic reconciliation timer still keeps the snapshot fresh
+    }
+}
+
+void WindowService::armCoalesceTimer() {
+    // Held changes produce no further X traffic, so the fd would not wake us for them.
+    // An armed timer that fires early just re-arms itself for the next deadline.
+    auto deadline = windowManager_->getNextChangeDeadline();
+    if (!deadline || (coalesceTimer_ >= 0 && coalesceDeadline_ <= *deadline)) {
+        return;
+    }
+    if (coalesceTimer_ >= 0) {
+        loop_.cancelTimer(coalesceTimer_);
+    }
+
+    coalesceDeadline_ = *deadline;
+    auto delay = std::chrono::ceil<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now());
+    coalesceTimer_ = loop_.addTimer(std::max(delay, std::chrono::milliseconds(1)), false, [this]() {
+        coalesceTimer_ = -1;
+        onChangeNotification();
+    });
+}
+
+void WindowService::scheduleRefresh() {
+    // Bursts of notifications collapse into one refresh; a refresh requested while
+    // another is running is replayed once it finishes
+    if (refreshInFlight_) {
+        refreshPending_ = true;
+        return;
+    }
+    if (refreshTimer_ >= 0) {
+        return;
+    }
+
+    refreshTimer_ = loop_.addTimer(REFRESH_COALESCE_DELAY, false, [this]() {
+        refreshTimer_ = -1;
+        startRefresh();
+    });
+}
+
+void WindowService::startRefresh() {
+    refreshInFlight_ = true;
+    xOwner_->submit([this]() {
+        windowManager_->refreshWindows();
+        publishLatestSnapshot();
+        loop_.post([this]() {
+            refreshInFlight_ = false;
+            // Watches for newly enumerated windows are applied on the notification connection
+            onChangeNotification();
+            if (refreshPending_) {
+                refreshPending_ = false;
+                scheduleRefresh();
+            }
+        });
+    });
+}
+
+void WindowService::publishLatestSnapshot() {
+    if (!publisher_) {
+        return;
+    }
+    auto snapshot = windowManager_->getLatestSnapshot();
+    if (snapshot && snapshot->generation != publisher_->getPublishedGeneration()) {
+        publisher_->publish(*snapshot);
+    }
+}
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
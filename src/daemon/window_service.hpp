@@ -0,0 +1,108 @@
+#pragma once
+
+#include "platform_config.h"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include "event_loop.hpp"
+#include "request_handler.hpp"
+#include "shared_snapshot.hpp"
+#include "task_worker.hpp"
+#include "../core/window_manager.hpp"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace WindowManager {
+
+/**
+ * Multi-client window service (Unix domain socket, line protocol)
+ * One epoll thread multiplexes the listening socket, every client, the X change
+ * notification fd, timers and signals. Queries are answered from the latest
+ * immutable snapshot without touching X; focus, validation and refreshes are
+ * queued to a single X owner thread so slow round trips never stall other clients.
+ * Every new snapshot is also published to shared memory for syscall-free readers.
+ */
+class WindowService {
+public:
+    static constexpr size_t MAX_REQUEST_LENGTH{64 * 1024};
+    static constexpr size_t MAX_PENDING_OUTPUT{8 * 1024 * 1024};    // Slow readers are dropped beyond this
+    static constexpr std::chrono::milliseconds REFRESH_COALESCE_DELAY{16};
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1000};          // Without change notifications
+    static constexpr std::chrono::milliseconds RECONCILE_INTERVAL{30000};    // With change notifications
+
+    // An empty sharedSnapshotName disables shared-memory publication
+    WindowService(std::unique_ptr<WindowManager> windowManager, std::string socketPath,
+                  std::string sharedSnapshotName = defaultSharedSnapshotName());
+    ~WindowService();
+
+    // Non-copyable, non-moveable (owns sockets and the X owner thread)
+    WindowService(const WindowService&) = delete;
+    WindowService& operator=(const WindowService&) = delete;
+    WindowService(WindowService&&) = delete;
+    WindowService& operator=(WindowService&&) = delete;
+
+    // Serves clients until SIGINT/SIGTERM or stop()
+    void run();
+    void stop(); // Thread-safe
+
+    // $XDG_RUNTIME_DIR/window-manager.sock, or /tmp/window-manager-<uid>.sock
+    static std::string defaultSocketPath();
+
+private:
+    struct Client {
+        int fd = -1;
+        std::string input;
+        std::string output;
+        std::deque<std::optional<std::string>> replies; // Keeps pipelined responses in request order
+        uint64_t firstReplySlot = 0;
+        bool wantsWrite = false;
+        bool closing = false;
+    };
+
+    std::unique_ptr<WindowManager> windowManager_;
+    std::string socketPath_;
+    std::string sharedSnapshotName_;
+    EventLoop loop_;
+    std::unique_ptr<TaskWorker> xOwner_;
+    std::unique_ptr<RequestHandler> handler_;
+    std::unique_ptr<SnapshotPublisher> publisher_; // Written from the X owner thread only
+
+    int listenFd_ = -1;
+    int signalFd_ = -1;
+    uint64_t nextClientId_ = 1;
+    uint64_t activeClientId_ = 0; // Client whose event is being handled (0 = none)
+    std::unordered_map<uint64_t, Client> clients_;
+
+    // Refresh coalescing (loop thread only)
+    int refreshTimer_ = -1;
+    bool refreshInFlight_ = false;
+    bool refreshPending_ = false;
+    int coalesceTimer_ = -1; // Fires when held (coalesced) title changes fall due
+    std::chrono::steady_clock::time_point coalesceDeadline_;
+
+    void openListenSocket();
+    void closeListenSocket();
+    void acceptClients();
+
+    void onClientEvent(uint64_t clientId, uint32_t events);
+    void readClient(uint64_t clientId, Client& client);
+    void processLines(uint64_t clientId, Client& client);
+    void deliverReply(uint64_t clientId, uint64_t slot, std::string response);
+    void flushClient(Client& client);
+    void closeClient(uint64_t clientId);
+
+    void onChangeNotification();
+    void armCoalesceTimer();
+    void scheduleRefresh();
+    void startRefresh();
+    void publishLatestSnapshot();
+};
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
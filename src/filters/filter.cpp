@@ -30,6 +30,10 @@ FilterResult WindowFilter::filterVisible(const std::vector<WindowInfo>& windows)
     return FilterResult(std::move(visibleWindows), windows.size(), emptyQuery, searchTime);
 }
 
+double WindowFilter::getCacheHitRatio() const {
+    return 0.0;
+}
+
 std::unique_ptr<WindowFilter> WindowFilter::create() {
     return std::make_unique<WindowFilterImpl>();
 }
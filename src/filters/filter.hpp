@@ -1,6 +1,7 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -36,6 +37,7 @@ public:
     // Performance optimization
     virtual void setCaching(bool enabled) = 0;
     virtual void clearCache() = 0;
+    virtual double getCacheHitRatio() const; // 0.0 for filters without a cache
 
     // Factory method
     static std::unique_ptr<WindowFilter> create();
@@ -71,13 +73,13 @@ public:
 
     // Statistics and diagnostics
     size_t getCacheSize() const;
-    double getCacheHitRatio() const;
+    double getCacheHitRatio() const override;
 
 private:
     bool cachingEnabled_;
     std::unordered_map<std::string, FilterResult> cache_;
-    mutable size_t cacheHits_;
-    mutable size_t cacheRequests_;
+    mutable std::atomic<size_t> cacheHits_;     // Read by the performance overlay on the UI thread
+    mutable std::atomic<size_t> cacheRequests_;
 
     // Helper methods
     std::string generateCacheKey(const std::vector<WindowInfo>& windows,
@@ -92,10 +92,13 @@ bool FilterResult::isValid() const {
 void FilterResult::groupByWorkspace() {
     windowsByWorkspace.clear();
     windowCountsByWorkspace.clear();
+    stateCounts = WindowStateCounts();
 
+    // One fused pass: grouping, per-workspace counts and state counts
     for (const auto& window : windows) {
         windowsByWorkspace[window.workspaceId].push_back(window);
         windowCountsByWorkspace[window.workspaceId]++;
+        stateCounts.add(window);
     }
 }
 
@@ -154,6 +157,9 @@ std::string FilterResult::toJson() const {
     oss << "    \"filteredCount\": " << filteredCount << ",\n";
     oss << "    \"searchTime\": " << searchTime.count() << ",\n";
     oss << "    \"query\": \"" << query.query << "\",\n";
+    if (!etag.empty()) {
+        oss << "    \"etag\": \"" << etag << "\",\n";
+    }
 
     // Format timestamp as ISO 8601
     auto now = std::chrono::system_clock::now();
@@ -247,23 +253,11 @@ std::string FilterResult::getCrossWorkspaceStatistics() const {
     std::ostringstream oss;
     oss << "{\n";
 
-    // Calculate window state statistics across all workspaces
-    size_t visibleWindows = 0;
-    size_t minimizedWindows = 0;
-    size_t focusedWindows = 0;
-    size_t hiddenWindows = 0;
-
-    for (const auto& window : windows) {
-        if (window.isVisible) visibleWindows++;
-        if (window.isMinimized) minimizedWindows++;
-        if (window.isFocused) focusedWindows++;
-        if (!window.isVisible) hiddenWindows++;
-    }
-
-    oss << "      \"visibleWindows\": " << visibleWindows << ",\n";
-    oss << "      \"minimizedWindows\": " << minimizedWindows << ",\n";
-    oss << "      \"focusedWindows\": " << focusedWindows << ",\n";
-    oss << "      \"hiddenWindows\": " << hiddenWindows << ",\n";
+    // Window state statistics across all workspaces (counted by groupByWorkspace())
+    oss << "      \"visibleWindows\": " << stateCounts.visible << ",\n";
+    oss << "      \"minimizedWindows\": " << stateCounts.minimized << ",\n";
+    oss << "      \"focusedWindows\": " << stateCounts.focused << ",\n";
+    oss << "      \"hiddenWindows\": " << stateCounts.hidden << ",\n";
 
     // Add workspace distribution statistics
     oss << "      \"workspaceDistribution\": {\n";
@@ -290,65 +284,46 @@ std::string FilterResult::getCrossWorkspaceStatistics() const {
 }
 
 WorkspaceStatistics FilterResult::getWorkspaceStatistics() const {
-    WorkspaceStatistics stats;
+    return WorkspaceStatistics::fromCounts(stateCounts, windows.size(), workspaces,
+                                           [this](const std::string& id) { return getWindowCountForWorkspace(id); });
+}
 
-    // Calculate totals
+WorkspaceStatistics WorkspaceStatistics::fromCounts(const WindowStateCounts& counts, size_t totalWindows,
+                                                    const std::vector<WorkspaceInfo>& workspaces,
+                                                    const std::function<size_t(const std::string&)>& countOn) {
+    WorkspaceStatistics stats;
     stats.totalWorkspaces = workspaces.size();
-    stats.totalWindows = windows.size();
-    stats.activeWorkspaces = 0;
+    stats.totalWindows = totalWindows;
+    stats.visibleWindows = counts.visible;
+    stats.minimizedWindows = counts.minimized;
+    stats.focusedWindows = counts.focused;
+    stats.hiddenWindows = counts.hidden;
 
-    // Calculate window state counts
-    for (const auto& window : windows) {
-        if (window.isVisible) stats.visibleWindows++;
-        if (window.isMinimized) stats.minimizedWindows++;
-        if (window.isFocused) stats.focusedWindows++;
-        if (!window.isVisible) stats.hiddenWindows++;
-    }
-
-    // Calculate active workspaces (those with windows)
+    // Distribution and active workspaces (those with windows) in one walk
     for (const auto& workspace : workspaces) {
-        if (getWindowCountForWorkspace(workspace.id) > 0) {
+        size_t count = countOn(workspace.id);
+        stats.windowsByWorkspace[workspace.id] = count;
+        if (count > 0) {
             stats.activeWorkspaces++;
         }
     }
 
-    // Build distribution map
-    for (const auto& workspace : workspaces) {
-        stats.windowsByWorkspace[workspace.id] = getWindowCountForWorkspace(workspace.id);
-    }
-
-    // Calculate average windows per workspace
     if (stats.activeWorkspaces > 0) {
         stats.averageWindowsPerWorkspace = static_cast<double>(stats.totalWindows) / stats.activeWorkspaces;
-    } else {
-        stats.averageWindowsPerWorkspace = 0.0;
     }
-
     return stats;
 }
 
 size_t FilterResult::getVisibleWindowCount() const {
-    size_t count = 0;
-    for (const auto& window : windows) {
-        if (window.isVisible) count++;
-    }
-    return count;
+    return stateCounts.visible;
 }
 
 size_t FilterResult::getMinimizedWindowCount() const {
-    size_t count = 0;
-    for (const auto& window : windows) {
-        if (window.isMinimized) count++;
-    }
-    return count;
+    return stateCounts.minimized;
 }
 
 size_t FilterResult::getFocusedWindowCount() const {
-    size_t count = 0;
-    for (const auto& window : windows) {
-        if (window.isFocused) count++;
-    }
-    return count;
+    return stateCounts.focused;
 }
 
 size_t FilterResult::getActiveWorkspaceCount() const {
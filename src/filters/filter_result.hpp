@@ -3,6 +3,7 @@
 #include <vector>
 #include <map>
 #include <chrono>
+#include <functional>
 #include "../core/window.hpp"
 #include "../core/workspace.hpp"
 #include "search_query.hpp"
@@ -20,6 +21,12 @@ struct WorkspaceStatistics {
     size_t hiddenWindows = 0;
     double averageWindowsPerWorkspace = 0.0;
     std::map<std::string, size_t> windowsByWorkspace;
+
+    // Assembles the statistics from state counts gathered in an earlier pass; only
+    // walks the workspace list. countOn(id) returns the windows on a workspace.
+    static WorkspaceStatistics fromCounts(const WindowStateCounts& counts, size_t totalWindows,
+                                          const std::vector<WorkspaceInfo>& workspaces,
+                                          const std::function<size_t(const std::string&)>& countOn);
 };
 
 /**
@@ -32,11 +39,13 @@ struct FilterResult {
     size_t filteredCount;
     std::chrono::milliseconds searchTime;
     SearchQuery query;
+    std::string etag; // Set by callers that serve conditional requests; emitted in toJson() metadata
 
     // T033: Enhanced workspace grouping support
     std::vector<WorkspaceInfo> workspaces;
     std::map<std::string, std::vector<WindowInfo>> windowsByWorkspace;
     std::map<std::string, size_t> windowCountsByWorkspace;
+    WindowStateCounts stateCounts; // Gathered in the same pass as the grouping
 
     // Constructors
     FilterResult() = default;
@@ -68,6 +77,7 @@ struct FilterResult {
     std::string toJsonWithWorkspaces() const;
 
     // T044: Cross-workspace window statistics
+    // Counts come from groupByWorkspace(); call it again after editing `windows`
     std::string getCrossWorkspaceStatistics() const;
     WorkspaceStatistics getWorkspaceStatistics() const;
     size_t getVisibleWindowCount() const;
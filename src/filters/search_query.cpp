@@ -82,6 +82,45 @@ bool SearchQuery::isEmpty() const {
     return query.empty();
 }
 
+std::vector<MatchSpan> SearchQuery::findMatchSpans(const std::string& text, SearchField textField) const {
+    std::vector<MatchSpan> spans;
+    if (query.empty() || text.empty() || (field != SearchField::Both && field != textField)) {
+        return spans;
+    }
+
+    // Lowercasing is byte-for-byte, so offsets map straight back onto the original text
+    std::string targetText = text;
+    std::string searchTerm = query;
+    if (!caseSensitive) {
+        std::transform(targetText.begin(), targetText.end(), targetText.begin(),
+                      [](unsigned char c) { return std::tolower(c); });
+        std::transform(searchTerm.begin(), searchTerm.end(), searchTerm.begin(),
+                      [](unsigned char c) { return std::tolower(c); });
+    }
+
+    if (useRegex) {
+        try {
+            std::regex pattern(searchTerm, caseSensitive ? std::regex::ECMAScript : std::regex::icase);
+            for (auto it = std::sregex_iterator(targetText.begin(), targetText.end(), pattern);
+                 it != std::sregex_iterator(); ++it) {
+                if (it->length() > 0) {
+                    spans.push_back({static_cast<size_t>(it->position()), static_cast<size_t>(it->length())});
+                }
+            }
+            return spans;
+        } catch (const std::regex_error&) {
+            // Same fallback as performStringMatch(): treat the pattern as a substring
+        }
+    }
+
+    for (size_t pos = targetText.find(searchTerm); pos != std::string::npos;
+         pos = targetText.find(searchTerm, pos + searchTerm.length())) {
+        spans.push_back({pos, searchTerm.length()});
+    }
+
+    return spans;
+}
+
 bool SearchQuery::isValid() const {
     // Check query length constraint (max 1000 characters as per data model)
     if (query.length() > 1000) {
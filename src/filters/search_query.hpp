@@ -2,6 +2,7 @@
 
 #include <string>
 #include <chrono>
+#include <vector>
 
 namespace WindowManager {
 
@@ -17,6 +18,14 @@ enum class SearchField {
     Both        // Search in both title and owner (default)
 };
 
+/**
+ * Byte range of a query match inside a title or owner name
+ */
+struct MatchSpan {
+    size_t offset = 0;
+    size_t length = 0;
+};
+
 /**
  * Enhanced search query supporting multiple fields
  * Backward compatible with existing single-field searches
@@ -48,6 +57,11 @@ struct SearchQuery {
     bool matchesOwner(const std::string& owner) const;
     bool isEmpty() const;
 
+    // Match positions for highlighting; computed on demand for displayed rows only.
+    // `textField` (Title or Owner) names the field `text` comes from; fields the query
+    // does not search get no spans, as matches() would not count them either.
+    std::vector<MatchSpan> findMatchSpans(const std::string& text, SearchField textField) const;
+
     // Validation and utility methods
     bool isValid() const;
     std::string toString() const;
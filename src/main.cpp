@@ -10,22 +10,69 @@
 #include "core/exceptions.hpp"
 #include "ui/cli.hpp"
 #include "ui/interactive.hpp"
+#include "daemon/window_service.hpp"
+#include "daemon/shared_snapshot.hpp"
+#include "daemon/batch_runner.hpp"
 #include "filters/search_query.hpp"
 #include "filters/filter_result.hpp"
 #include "platform_config.h"
 
+#ifdef WINDOWS_PLATFORM
+#include <io.h>
+#include <cstdio>
+#else
+#include <unistd.h>
+#endif
+
 // Function declarations for different modes
-int listWindows(bool verbose = false, const std::string& format = "text", bool showHandles = false, bool handlesOnly = false);
-int searchWindows(const std::string& keyword, bool caseSensitive = false, bool verbose = false, const std::string& format = "text");
+int listWindows(bool verbose = false, const std::string& format = "text", bool showHandles = false, bool handlesOnly = false,
+                const std::string& ifChanged = "");
+int searchWindows(const std::string& keyword, bool caseSensitive = false, bool verbose = false, const std::string& format = "text",
+                  const std::string& ifChanged = "");
 int focusWindow(const std::string& handle, bool verbose = false, const std::string& format = "text",
                 bool allowWorkspaceSwitch = true, int timeout = 5);
 int validateHandle(const std::string& handle, bool verbose = false, const std::string& format = "text");
-int interactiveMode(const std::string& format = "text");
+int interactiveMode(const std::string& format = "text", bool stayOpenAfterFocus = false,
+                    unsigned int maxFrameRate = WindowManager::RedrawScheduler::DEFAULT_MAX_FRAME_RATE,
+                    std::chrono::milliseconds coalesceLatency = WindowManager::ChangeCoalescer::DEFAULT_LATENCY);
+int daemonMode(const std::string& socketPath, const std::string& sharedSnapshotName, bool verbose = false,
+               std::chrono::milliseconds coalesceLatency = WindowManager::ChangeCoalescer::DEFAULT_LATENCY);
+int batchMode(bool flushPerBatch = false);
+int peekWindows(const std::string& sharedSnapshotName, bool verbose = false, const std::string& format = "text",
+                bool showHandles = false);
+bool isStdoutTerminal();
 void printUsage(const char* programName);
 void printVersion();
 void printPlatformSpecificHelp();
 void printDetailedErrorGuidance(const std::string& errorType);
 
+namespace {
+
+// X displays selected with --displays; empty = the default display
+std::vector<std::string> selectedDisplays;
+
+std::vector<std::string> splitDisplayList(const std::string& list) {
+    std::vector<std::string> displays;
+    size_t start = 0;
+    while (start <= list.length()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.length();
+        }
+        if (end > start) {
+            displays.push_back(list.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return displays;
+}
+
+std::unique_ptr<WindowManager::WindowManager> createWindowManager() {
+    return WindowManager::WindowManager::create(selectedDisplays);
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
     try {
         // Parse command line arguments
@@ -58,6 +105,8 @@ int main(int argc, char* argv[]) {
         bool verbose = false;
         bool caseSensitive = false;
         std::string format = "text";
+        std::string ifChanged;
+        std::chrono::milliseconds coalesceLatency = WindowManager::ChangeCoalescer::DEFAULT_LATENCY;
 
         for (size_t i = 2; i < args.size(); ++i) {
             if (args[i] == "--verbose") {
@@ -75,6 +124,32 @@ int main(int argc, char* argv[]) {
                     std::cerr << "Error: --format requires an argument (text|json)\n";
                     return 1;
                 }
+            } else if (args[i] == "--if-changed") {
+                if (i + 1 < args.size()) {
+                    ifChanged = args[++i];
+                } else {
+                    std::cerr << "Error: --if-changed requires an etag\n";
+                    return 1;
+                }
+            } else if (args[i] == "--coalesce-ms") {
+                if (i + 1 < args.size()) {
+                    try {
+                        coalesceLatency = std::chrono::milliseconds(std::stoul(args[++i]));
+                    } catch (const std::exception&) {
+                        std::cerr << "Error: Invalid --coalesce-ms value\n";
+                        return 1;
+                    }
+                } else {
+                    std::cerr << "Error: --coalesce-ms requires a value\n";
+                    return 1;
+                }
+            } else if (args[i] == "--displays") {
+                if (i + 1 < args.size()) {
+                    selectedDisplays = splitDisplayList(args[++i]);
+                } else {
+                    std::cerr << "Error: --displays requires a comma-separated list (e.g. :0,:1)\n";
+                    return 1;
+                }
             }
         }
 
@@ -93,7 +168,7 @@ int main(int argc, char* argv[]) {
                 // Other options like --verbose and --format are already parsed above
             }
 
-            return listWindows(verbose, format, showHandles, handlesOnly);
+            return listWindows(verbose, format, showHandles, handlesOnly, ifChanged);
         } else if (command == "search") {
             if (args.size() < 3) {
                 std::cerr << "Error: search command requires a keyword\n";
@@ -101,7 +176,7 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
             std::string keyword = args[2];
-            return searchWindows(keyword, caseSensitive, verbose, format);
+            return searchWindows(keyword, caseSensitive, verbose, format, ifChanged);
         } else if (command == "focus") {
             if (args.size() < 3) {
                 std::cerr << "Error: focus command requires a window handle\n";
@@ -142,7 +217,62 @@ int main(int argc, char* argv[]) {
             std::string handle = args[2];
             return validateHandle(handle, verbose, format);
         } else if (command == "interactive") {
-            return interactiveMode(format);
+            bool stayOpenAfterFocus = false;
+            unsigned int maxFrameRate = WindowManager::RedrawScheduler::DEFAULT_MAX_FRAME_RATE;
+            for (size_t i = 2; i < args.size(); ++i) {
+                if (args[i] == "--stay-open") {
+                    stayOpenAfterFocus = true;
+                } else if (args[i] == "--max-fps") {
+                    if (i + 1 < args.size()) {
+                        try {
+                            maxFrameRate = static_cast<unsigned int>(std::stoul(args[++i]));
+                        } catch (const std::exception&) {
+                            std::cerr << "Error: Invalid --max-fps value\n";
+                            return 1;
+                        }
+                    } else {
+                        std::cerr << "Error: --max-fps requires a value\n";
+                        return 1;
+                    }
+                }
+            }
+            return interactiveMode(format, stayOpenAfterFocus, maxFrameRate, coalesceLatency);
+        } else if (command == "batch") {
+            bool flushPerBatch = false;
+            for (size_t i = 2; i < args.size(); ++i) {
+                if (args[i] == "--flush") {
+                    if (i + 1 < args.size() && (args[i + 1] == "response" || args[i + 1] == "batch")) {
+                        flushPerBatch = args[++i] == "batch";
+                    } else {
+                        std::cerr << "Error: --flush requires 'response' or 'batch'\n";
+                        return 1;
+                    }
+                }
+            }
+            return batchMode(flushPerBatch);
+        } else if (command == "daemon" || command == "peek") {
+            std::string socketPath;
+            std::string sharedSnapshotName;
+            bool showHandles = false;
+            for (size_t i = 2; i < args.size(); ++i) {
+                if (args[i] == "--socket" || args[i] == "--shm") {
+                    if (i + 1 >= args.size()) {
+                        std::cerr << "Error: " << args[i] << " requires a value\n";
+                        return 1;
+                    }
+                    if (args[i] == "--socket") {
+                        socketPath = args[++i];
+                    } else {
+                        sharedSnapshotName = args[++i];
+                    }
+                } else if (args[i] == "--show-handles") {
+                    showHandles = true;
+                }
+            }
+            if (command == "peek") {
+                return peekWindows(sharedSnapshotName, verbose, format, showHandles);
+            }
+            return daemonMode(socketPath, sharedSnapshotName, verbose, coalesceLatency);
         } else {
             std::cerr << "Error: Unknown command '" << command << "'\n";
             printUsage(argv[0]);
@@ -174,10 +304,11 @@ int main(int argc, char* argv[]) {
     }
 }
 
-int listWindows(bool verbose, const std::string& format, bool showHandles, bool handlesOnly) {
+int listWindows(bool verbose, const std::string& format, bool showHandles, bool handlesOnly,
+                const std::string& ifChanged) {
     try {
         // Create window manager
-        auto windowManager = WindowManager::WindowManager::create();
+        auto windowManager = createWindowManager();
 
         // Set up CLI
         WindowManager::CLI cli;
@@ -186,9 +317,18 @@ int listWindows(bool verbose, const std::string& format, bool showHandles, bool
 
         // Get all windows
         auto start = std::chrono::steady_clock::now();
-        auto windows = windowManager->getAllWindows();
+        auto snapshot = windowManager->getSnapshot();
         auto end = std::chrono::steady_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+        const auto& windows = snapshot->windows;
+
+        // Conditional request: nothing to print when the caller already has this list
+        std::string etag = WindowManager::formatEtag(snapshot->etag);
+        if (!ifChanged.empty() && ifChanged == etag) {
+            cli.displayNotModified(etag);
+            return 0;
+        }
+        cli.setEtag(etag);
 
         // Display windows based on options
         if (showHandles || handlesOnly) {
@@ -197,6 +337,10 @@ int listWindows(bool verbose, const std::string& format, bool showHandles, bool
             cli.displayAllWindows(windows);
         }
 
+        if (verbose || !ifChanged.empty()) {
+            cli.displayInfo("ETag: " + etag);
+        }
+
         // Show performance stats if verbose
         if (verbose) {
             cli.displayPerformanceStats(duration, windows.size());
@@ -221,15 +365,17 @@ int listWindows(bool verbose, const std::string& format, bool showHandles, bool
     }
 }
 
-int searchWindows(const std::string& keyword, bool caseSensitive, bool verbose, const std::string& format) {
+int searchWindows(const std::string& keyword, bool caseSensitive, bool verbose, const std::string& format,
+                  const std::string& ifChanged) {
     try {
         // Create window manager
-        auto windowManager = WindowManager::WindowManager::create();
+        auto windowManager = createWindowManager();
 
         // Set up CLI
         WindowManager::CLI cli;
         cli.setOutputFormat(format);
         cli.setVerbose(verbose);
+        cli.setHighlightMatches(format == "text" && isStdoutTerminal());
 
         // Create search query
         WindowManager::SearchQuery query(keyword, WindowManager::SearchField::Both, caseSensitive, false);
@@ -250,12 +396,23 @@ int searchWindows(const std::string& keyword, bool caseSensitive, bool verbose,
             std::cerr << "Debug: Found " << result.filteredCount << " matches out of " << result.totalCount << " total windows" << std::endl;
         }
 
+        // Conditional request: the etag covers exactly the matched windows
+        result.etag = WindowManager::formatEtag(WindowManager::computeEtag(result.windows));
+        if (!ifChanged.empty() && ifChanged == result.etag) {
+            cli.displayNotModified(result.etag);
+            return 0;
+        }
+        cli.setEtag(result.etag);
+
         // Display results
         if (result.filteredCount > 0) {
             cli.displayFilteredResults(result);
         } else {
             cli.displayNoMatches(keyword);
         }
+        if (verbose || !ifChanged.empty()) {
+            cli.displayInfo("ETag: " + result.etag);
+        }
 
         // Show performance warning if needed
         if (!result.meetsPerformanceTarget()) {
@@ -289,7 +446,7 @@ int focusWindow(const std::string& handle, bool verbose, const std::string& form
     // T043: Use timeout parameter for focus operations
     try {
         // Create window manager
-        auto windowManager = WindowManager::WindowManager::create();
+        auto windowManager = createWindowManager();
 
         // Set up CLI
         WindowManager::CLI cli;
@@ -373,7 +530,7 @@ int focusWindow(const std::string& handle, bool verbose, const std::string& form
 int validateHandle(const std::string& handle, bool verbose, const std::string& format) {
     try {
         // Create window manager
-        auto windowManager = WindowManager::WindowManager::create();
+        auto windowManager = createWindowManager();
 
         // Set up CLI
         WindowManager::CLI cli;
@@ -452,13 +609,17 @@ int validateHandle(const std::string& handle, bool verbose, const std::string& f
     }
 }
 
-int interactiveMode(const std::string& format) {
+int interactiveMode(const std::string& format, bool stayOpenAfterFocus, unsigned int maxFrameRate,
+                    std::chrono::milliseconds coalesceLatency) {
     try {
         // Create window manager
-        auto windowManager = WindowManager::WindowManager::create();
+        auto windowManager = createWindowManager();
+        windowManager->setChangeCoalescingLatency(coalesceLatency);
 
         // Create interactive UI
         WindowManager::InteractiveUI ui(std::move(windowManager));
+        ui.setStayOpenAfterFocus(stayOpenAfterFocus);
+        ui.setMaxFrameRate(maxFrameRate);
 
         // Note: format parameter is ignored in interactive mode as it uses FTXUI
         if (format != "text") {
@@ -477,6 +638,103 @@ int interactiveMode(const std::string& format) {
     }
 }
 
+int batchMode(bool flushPerBatch) {
+    try {
+        auto windowManager = createWindowManager();
+
+        std::ios::sync_with_stdio(false);
+        WindowManager::BatchRunner runner(*windowManager, std::cin, std::cout,
+                                          flushPerBatch ? WindowManager::BatchRunner::FlushMode::PerBatch
+                                                        : WindowManager::BatchRunner::FlushMode::PerResponse);
+        return runner.run() == 0 ? 0 : 1;
+
+    } catch (const WindowManager::WindowManagerException& e) {
+        std::cerr << "Window Manager Error: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+int daemonMode(const std::string& socketPath, const std::string& sharedSnapshotName, bool verbose,
+               std::chrono::milliseconds coalesceLatency) {
+#ifdef WM_PLATFORM_LINUX
+    try {
+        auto windowManager = createWindowManager();
+        windowManager->setChangeCoalescingLatency(coalesceLatency);
+        std::string path = socketPath.empty() ? WindowManager::WindowService::defaultSocketPath() : socketPath;
+        std::string shmName = sharedSnapshotName.empty() ? WindowManager::defaultSharedSnapshotName() : sharedSnapshotName;
+
+        WindowManager::WindowService service(std::move(windowManager), path, shmName);
+        if (verbose) {
+            std::cerr << "Serving window queries on " << path << " (snapshot in shared memory " << shmName << ")"
+                      << std::endl;
+        }
+        service.run();
+        return 0;
+
+    } catch (const WindowManager::WindowManagerException& e) {
+        std::cerr << "Window Manager Error: " << e.what() << std::endl;
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+#else
+    (void)socketPath;
+    (void)sharedSnapshotName;
+    (void)verbose;
+    (void)coalesceLatency;
+    std::cerr << "Error: daemon mode is only available on Linux" << std::endl;
+    return 1;
+#endif
+}
+
+int peekWindows(const std::string& sharedSnapshotName, bool verbose, const std::string& format, bool showHandles) {
+#ifdef WM_PLATFORM_LINUX
+    std::string shmName = sharedSnapshotName.empty() ? WindowManager::defaultSharedSnapshotName() : sharedSnapshotName;
+    try {
+        WindowManager::SnapshotReader reader(shmName);
+        auto snapshot = reader.read();
+        if (!snapshot) {
+            std::cerr << "Error: snapshot kept changing while reading, try again" << std::endl;
+            return 1;
+        }
+
+        WindowManager::CLI cli;
+        cli.setOutputFormat(format);
+        cli.setVerbose(verbose);
+        if (showHandles) {
+            cli.displayAllWindowsWithHandles(snapshot->windows);
+        } else {
+            cli.displayAllWindows(snapshot->windows);
+        }
+
+        if (verbose) {
+            auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - snapshot->capturedAt);
+            cli.displayInfo("Snapshot generation " + std::to_string(snapshot->generation) + ", " +
+                            std::to_string(age.count()) + "ms old, published by daemon pid " +
+                            std::to_string(reader.getWriterPid()));
+        }
+        return 0;
+
+    } catch (const WindowManager::PlatformApiException&) {
+        std::cerr << "Error: no window snapshot published at " << shmName
+                  << " (is 'window-manager daemon' running?)" << std::endl;
+        return 1;
+    }
+#else
+    (void)sharedSnapshotName;
+    (void)verbose;
+    (void)format;
+    (void)showHandles;
+    std::cerr << "Error: peek is only available on Linux" << std::endl;
+    return 1;
+#endif
+}
+
 void printUsage(const char* programName) {
     std::cout << "Window List and Filter Program\n";
     std::cout << "Usage: " << programName << " [options] <command> [args...]\n\n";
@@ -485,7 +743,10 @@ void printUsage(const char* programName) {
     std::cout << "  search <keyword>        Search windows by keyword\n";
     std::cout << "  focus <handle>          Focus window by handle (with workspace switching)\n";
     std::cout << "  validate-handle <handle> Validate window handle format and existence\n";
-    std::cout << "  interactive             Start interactive filtering mode\n\n";
+    std::cout << "  interactive             Start interactive filtering mode\n";
+    std::cout << "  batch                   Run newline-delimited requests from stdin against one warm instance\n";
+    std::cout << "  daemon                  Serve window queries over a Unix socket (Linux)\n";
+    std::cout << "  peek                    List windows from the daemon's shared-memory snapshot (Linux)\n\n";
     std::cout << "Options:\n";
     std::cout << "  --help, -h              Show this help message\n";
     std::cout << "  --version, -v           Show version information\n";
@@ -496,13 +757,22 @@ void printUsage(const char* programName) {
     std::cout << "  --no-workspace-switch   Prevent automatic workspace switching (focus command)\n";
     std::cout << "  --timeout <seconds>     Set operation timeout (focus command)\n";
     std::cout << "  --show-handles          Show window handles in list output\n";
-    std::cout << "  --handles-only          Show only handles and titles (compact format)\n\n";
+    std::cout << "  --handles-only          Show only handles and titles (compact format)\n";
+    std::cout << "  --if-changed <etag>     Print only a short 'not modified' reply if the list/search result is unchanged\n";
+    std::cout << "  --stay-open             Keep interactive mode open after focusing a window\n";
+    std::cout << "  --max-fps <n>           Cap interactive redraws per second (default 60, 0 = uncapped)\n";
+    std::cout << "  --coalesce-ms <n>       Coalesce title-change bursts per window (interactive, daemon; default 250, 0 = off)\n";
+    std::cout << "  --displays <list>       Enumerate several X displays in parallel (Linux; e.g. :0,:1)\n";
+    std::cout << "  --flush <response|batch> Batch output flushing (default response; batch = at blank lines/EOF)\n";
+    std::cout << "  --socket <path>         Daemon socket path (default $XDG_RUNTIME_DIR/window-manager.sock)\n";
+    std::cout << "  --shm <name>            Shared-memory snapshot name (daemon, peek; default /window-manager-<uid>)\n\n";
     std::cout << "Examples:\n";
     std::cout << "  " << programName << " list\n";
     std::cout << "  " << programName << " list --format json --verbose\n";
     std::cout << "  " << programName << " list --show-handles\n";
     std::cout << "  " << programName << " list --handles-only\n";
     std::cout << "  " << programName << " search chrome\n";
+    std::cout << "  " << programName << " list --format json --if-changed 9f3c2a7b41d0e658\n";
     std::cout << "  " << programName << " search \"Google Chrome\" --case-sensitive\n";
     std::cout << "  " << programName << " focus 12345\n";
     std::cout << "  " << programName << " focus 12345 --verbose\n";
@@ -511,6 +781,11 @@ void printUsage(const char* programName) {
     std::cout << "  " << programName << " validate-handle 12345\n";
     std::cout << "  " << programName << " validate-handle 12345 --format json\n";
     std::cout << "  " << programName << " interactive\n";
+    std::cout << "  " << programName << " interactive --stay-open\n";
+    std::cout << "  printf 'list\\nfocus 12345\\n' | " << programName << " batch\n";
+    std::cout << "  " << programName << " daemon --socket /tmp/wm.sock\n";
+    std::cout << "  " << programName << " peek --format json\n";
+    std::cout << "  " << programName << " list --displays :0,:1\n";
 }
 
 void printVersion() {
@@ -519,6 +794,14 @@ void printVersion() {
     std::cout << "Built with C++17 and CMake\n";
 }
 
+bool isStdoutTerminal() {
+#ifdef WINDOWS_PLATFORM
+    return _isatty(_fileno(stdout)) != 0;
+#else
+    return isatty(STDOUT_FILENO) != 0;
+#endif
+}
+
 void printPlatformSpecificHelp() {
     std::cout << "\nPlatform-Specific Information:\n";
     std::cout << "============================\n";
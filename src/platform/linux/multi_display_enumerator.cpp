@@ -0,0 +1,539 @@
+#include "multi_display_enumerator.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include "../../core/exceptions.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <X11/Xlib.h>
+
+namespace WindowManager {
+
+MultiDisplayEnumerator::MultiDisplayEnumerator(const std::vector<std::string>& displayNames)
+    : epollFd_(-1)
+    , wakeFd_(-1) {
+
+    if (displayNames.empty()) {
+        throw ConfigurationException("displays", "at least one display is required");
+    }
+
+    // Connections are driven from one thread per display
+    XInitThreads();
+
+    // Opened here, one after another: X11Enumerator installs the process-wide error
+    // handler on first use. Only enumeration has to be parallel.
+    for (const auto& name : displayNames) {
+        auto display = std::make_unique<DisplayConnection>();
+        display->name = name;
+        display->enumerator = std::make_unique<X11Enumerator>(name);
+        display->worker = std::make_unique<TaskWorker>();
+        displays_.push_back(std::move(display));
+    }
+
+    // The displays' event connections are added on first use (registerChangeNotifications())
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd_ < 0) {
+        throw PlatformApiException("epoll_create1", errno, std::strerror(errno));
+    }
+
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd_ < 0) {
+        int error = errno;
+        close(epollFd_);
+        throw PlatformApiException("eventfd", error, std::strerror(error));
+    }
+}
+
+MultiDisplayEnumerator::~MultiDisplayEnumerator() {
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+    }
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+    }
+}
+
+std::string MultiDisplayEnumerator::qualify(const std::string& display, const std::string& id) {
+    return display + HANDLE_SEPARATOR + id;
+}
+
+bool MultiDisplayEnumerator::splitQualified(const std::string& qualifiedId, std::string& display, std::string& local) {
+    // The last separator: X ids are hex or decimal, while "tcp/host:0" style display names contain one
+    auto separator = qualifiedId.rfind(HANDLE_SEPARATOR);
+    if (separator == std::string::npos) {
+        display.clear();
+        local = qualifiedId;
+        return false;
+    }
+    display = qualifiedId.substr(0, separator);
+    local = qualifiedId.substr(separator + 1);
+    return true;
+}
+
+template <typename Result>
+std::future<Result> MultiDisplayEnumerator::submit(DisplayConnection& display,
+                                                   std::function<Result(X11Enumerator&)> task) {
+    auto promise = std::make_shared<std::promise<Result>>();
+    auto future = promise->get_future();
+    X11Enumerator& enumerator = *display.enumerator;
+
+    display.worker->submit([promise, task = std::move(task), &enumerator]() {
+        try {
+            promise->set_value(task(enumerator));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+MultiDisplayEnumerator::DisplayConnection* MultiDisplayEnumerator::resolve(const std::string& qualifiedId,
+                                                                           std::string& local) {
+    std::string name;
+    if (!splitQualified(qualifiedId, name, local)) {
+        return displays_.front().get();
+    }
+
+    for (auto& display : displays_) {
+        if (display->name == name) {
+            return display.get();
+        }
+    }
+    return nullptr;
+}
+
+void MultiDisplayEnumerator::qualifyWindow(const std::string& display, WindowInfo& window) {
+    window.handle = qualify(display, window.handle);
+    window.display = display;
+    if (!window.workspaceId.empty()) {
+        window.workspaceId = qualify(display, window.workspaceId);
+    }
+}
+
+void MultiDisplayEnumerator::qualifyWorkspace(const std::string& display, WorkspaceInfo& workspace) {
+    workspace.id = qualify(display, workspace.id);
+    workspace.name = display + " " + workspace.name;
+    for (auto& handle : workspace.windowHandles) {
+        handle = qualify(display, handle);
+    }
+}
+
+std::vector<WindowInfo> MultiDisplayEnumerator::enumerateWindows() {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::future<std::vector<WindowInfo>>> pending;
+    pending.reserve(displays_.size());
+    for (auto& display : displays_) {
+        pending.push_back(submit<std::vector<WindowInfo>>(*display, [](X11Enumerator& enumerator) {
+            return enumerator.enumerateWindows();
+        }));
+    }
+
+    // Every future is collected before rethrowing, so no task outlives the call
+    std::vector<WindowInfo> windows;
+    std::exception_ptr failure;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        try {
+            auto displayWindows = pending[i].get();
+            for (auto& window : displayWindows) {
+                qualifyWindow(displays_[i]->name, window);
+                windows.push_back(std::move(window));
+            }
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    cachedWindows_ = windows;
+    updateEnumerationTime(start, std::chrono::steady_clock::now());
+    return windows;
+}
+
+bool MultiDisplayEnumerator::refreshWindowList() {
+    try {
+        enumerateWindows();
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+std::optional<WindowInfo> MultiDisplayEnumerator::getWindowInfo(const std::string& handle) {
+    std::string local;
+    DisplayConnection* display = resolve(handle, local);
+    if (!display) {
+        return std::nullopt;
+    }
+
+    auto window = submit<std::optional<WindowInfo>>(*display, [local](X11Enumerator& enumerator) {
+        return enumerator.getWindowInfo(local);
+    }).get();
+    if (window) {
+        qualifyWindow(display->name, *window);
+    }
+    return window;
+}
+
+bool MultiDisplayEnumerator::focusWindow(const std::string& handle) {
+    std::string local;
+    DisplayConnection* display = resolve(handle, local);
+    if (!display) {
+        return false;
+    }
+
+    return submit<bool>(*display, [local](X11Enumerator& enumerator) {
+        return enumerator.focusWindow(local);
+    }).get();
+}
+
+bool MultiDisplayEnumerator::isWindowValid(const std::string& handle) {
+    std::string local;
+    DisplayConnection* display = resolve(handle, local);
+    if (!display) {
+        return false;
+    }
+
+    return submit<bool>(*display, [local](X11Enumerator& enumerator) {
+        return enumerator.isWindowValid(local);
+    }).get();
+}
+
+std::vector<WorkspaceInfo> MultiDisplayEnumerator::enumerateWorkspaces() {
+    auto states = collectDisplayStates(true);
+
+    // One current workspace overall, like a single display: the focused display's
+    size_t active = focusedDisplayIndex(states);
+    std::vector<WorkspaceInfo> workspaces;
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (auto& workspace : states[i].workspaces) {
+            qualifyWorkspace(displays_[i]->name, workspace);
+            workspace.isCurrent = workspace.isCurrent && i == active;
+            workspace.index = static_cast<int>(workspaces.size());
+            workspaces.push_back(std::move(workspace));
+        }
+    }
+
+    cachedWorkspaces_ = workspaces;
+    return workspaces;
+}
+
+std::optional<WorkspaceInfo> MultiDisplayEnumerator::getCurrentWorkspace() {
+    auto states = collectDisplayStates(false);
+
+    size_t active = focusedDisplayIndex(states);
+    auto workspace = std::move(states[active].current);
+    if (workspace) {
+        qualifyWorkspace(displays_[active]->name, *workspace);
+    }
+    return workspace;
+}
+
+std::vector<MultiDisplayEnumerator::DisplayState> MultiDisplayEnumerator::collectDisplayStates(bool withWorkspaces) {
+    std::vector<std::future<DisplayState>> pending;
+    pending.reserve(displays_.size());
+    for (auto& display : displays_) {
+        pending.push_back(submit<DisplayState>(*display, [withWorkspaces](X11Enumerator& enumerator) {
+            DisplayState state;
+            state.hasFocus = enumerator.getFocusedWindow().has_value();
+            if (withWorkspaces) {
+                state.workspaces = enumerator.enumerateWorkspaces();
+            } else {
+                state.current = enumerator.getCurrentWorkspace();
+            }
+            return state;
+        }));
+    }
+
+    // Every future is collected before rethrowing, as in enumerateWindows()
+    std::vector<DisplayState> states(pending.size());
+    std::exception_ptr failure;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        try {
+            states[i] = pending[i].get();
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return states;
+}
+
+size_t MultiDisplayEnumerator::focusedDisplayIndex(const std::vector<DisplayState>& states) {
+    // The first display with a focused window, as in getFocusedWindow(); else the first display
+    for (size_t i = 0; i < states.size(); ++i) {
+        if (states[i].hasFocus) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+std::vector<WindowInfo> MultiDisplayEnumerator::enumerateAllWorkspaceWindows() {
+    return enumerateWindows();
+}
+
+std::vector<WindowInfo> MultiDisplayEnumerator::getWindowsOnWorkspace(const std::string& workspaceId) {
+    std::vector<WindowInfo> windows;
+    for (auto& window : enumerateWindows()) {
+        if (window.workspaceId == workspaceId) {
+            windows.push_back(std::move(window));
+        }
+    }
+    return windows;
+}
+
+std::optional<WindowInfo> MultiDisplayEnumerator::getEnhancedWindowInfo(const std::string& handle) {
+    std::string local;
+    DisplayConnection* display = resolve(handle, local);
+    if (!display) {
+        return std::nullopt;
+    }
+
+    auto window = submit<std::optional<WindowInfo>>(*display, [local](X11Enumerator& enumerator) {
+        return enumerator.getEnhancedWindowInfo(local);
+    }).get();
+    if (window) {
+        qualifyWindow(display->name, *window);
+    }
+    return window;
+}
+
+bool MultiDisplayEnumerator::isWorkspaceSupported() const {
+    return displays_.front()->enumerator->isWorkspaceSupported();
+}
+
+std::optional<WindowInfo> MultiDisplayEnumerator::getFocusedWindow() {
+    std::vector<std::future<std::optional<WindowInfo>>> pending;
+    pending.reserve(displays_.size());
+    for (auto& display : displays_) {
+        pending.push_back(submit<std::optional<WindowInfo>>(*display, [](X11Enumerator& enumerator) {
+            return enumerator.getFocusedWindow();
+        }));
+    }
+
+    std::optional<WindowInfo> focused;
+    std::exception_ptr failure;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        try {
+            auto window = pending[i].get();
+            if (window && !focused) {
+                qualifyWindow(displays_[i]->name, *window);
+                focused = std::move(window);
+            }
+        } catch (...) {
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    return focused;
+}
+
+bool MultiDisplayEnumerator::switchToWorkspace(const std::string& workspaceId) {
+    std::string local;
+    DisplayConnection* display = resolve(workspaceId, local);
+    if (!display) {
+        return false;
+    }
+
+    return submit<bool>(*display, [local](X11Enumerator& enumerator) {
+        return enumerator.switchToWorkspace(local);
+    }).get();
+}
+
+bool MultiDisplayEnumerator::canSwitchWorkspaces() const {
+    return displays_.front()->enumerator->canSwitchWorkspaces();
+}
+
+// Notification calls go straight to the enumerators: they only touch each display's
+// dedicated event connection, never the one the workers are using
+
+bool MultiDisplayEnumerator::supportsChangeNotifications() const {
+    return std::any_of(displays_.begin(), displays_.end(), [](const auto& display) {
+        return display->enumerator->supportsChangeNotifications();
+    });
+}
+
+void MultiDisplayEnumerator::registerChangeNotifications() const {
+    std::call_once(epollRegistered_, [this]() {
+        // Opens each display's event connection
+        for (const auto& display : displays_) {
+            int fd = display->enumerator->getChangeNotificationFd();
+            if (fd < 0) {
+                continue;
+            }
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            // EEXIST: added before a later display failed and this call is a retry
+            if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) < 0 && errno != EEXIST) {
+                throw PlatformApiException("epoll_ctl(ADD)", errno, std::strerror(errno));
+            }
+        }
+    });
+}
+
+bool MultiDisplayEnumerator::waitForChanges(std::chrono::milliseconds timeout) {
+    registerChangeNotifications(); // Every connection may fail to open
+    if (!supportsChangeNotifications()) {
+        return WindowEnumerator::waitForChanges(timeout);
+    }
+
+    // Events may already be queued client-side, in which case epoll would not wake
+    if (processChangeNotifications()) {
+        return true;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+
+        // Wake early for held title changes on any display
+        auto wake = deadline;
+        auto held = getNextChangeDeadline();
+        if (held && *held < wake) {
+            wake = *held;
+        }
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+
+        // The epoll fd becomes readable when any display's event connection does
+        pollfd descriptors[2] = {};
+        descriptors[0].fd = epollFd_;
+        descriptors[0].events = POLLIN;
+        descriptors[1].fd = wakeFd_;
+        descriptors[1].events = POLLIN;
+
+        int ready = poll(descriptors, 2, static_cast<int>(wait.count()));
+        if (ready < 0 && errno != EINTR) {
+            return false;
+        }
+
+        if (ready > 0 && (descriptors[1].revents & POLLIN)) {
+            uint64_t count;
+            while (read(wakeFd_, &count, sizeof(count)) > 0) {
+            }
+            return processChangeNotifications();
+        }
+
+        if ((ready > 0 || held) && processChangeNotifications()) {
+            return true;
+        }
+    }
+}
+
+void MultiDisplayEnumerator::interruptWaitForChanges() {
+    if (!supportsChangeNotifications()) {
+        WindowEnumerator::interruptWaitForChanges(); // waitForChanges() is polling
+        return;
+    }
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        // Counter saturated: a wake-up is already pending
+    }
+}
+
+int MultiDisplayEnumerator::getChangeNotificationFd() const {
+    registerChangeNotifications();
+    return supportsChangeNotifications() ? epollFd_ : -1;
+}
+
+bool MultiDisplayEnumerator::processChangeNotifications() {
+    // Every display is drained, even after one reported a change
+    bool changed = false;
+    for (auto& display : displays_) {
+        changed = display->enumerator->processChangeNotifications() || changed;
+    }
+    return changed;
+}
+
+void MultiDisplayEnumerator::setChangeCoalescingLatency(std::chrono::milliseconds latency) {
+    for (auto& display : displays_) {
+        display->enumerator->setChangeCoalescingLatency(latency);
+    }
+}
+
+std::optional<std::chrono::steady_clock::time_point> MultiDisplayEnumerator::getNextChangeDeadline() const {
+    std::optional<std::chrono::steady_clock::time_point> next;
+    for (const auto& display : displays_) {
+        auto deadline = display->enumerator->getNextChangeDeadline();
+        if (deadline && (!next || *deadline < *next)) {
+            next = deadline;
+        }
+    }
+    return next;
+}
+
+ChangeCoalescingStats MultiDisplayEnumerator::getChangeCoalescingStats() const {
+    ChangeCoalescingStats total;
+    for (const auto& display : displays_) {
+        auto stats = display->enumerator->getChangeCoalescingStats();
+        total.received += stats.received;
+        total.delivered += stats.delivered;
+    }
+    return total;
+}
+
+std::optional<WindowThumbnail> MultiDisplayEnumerator::captureThumbnail(const std::string& handle,
+                                                                        unsigned int maxWidth,
+                                                                        unsigned int maxHeight) {
+    std::string local;
+    DisplayConnection* display = resolve(handle, local);
+    if (!display) {
+        return std::nullopt;
+    }
+
+    return submit<std::optional<WindowThumbnail>>(*display, [local, maxWidth, maxHeight](X11Enumerator& enumerator) {
+        return enumerator.captureThumbnail(local, maxWidth, maxHeight);
+    }).get();
+}
+
+std::chrono::milliseconds MultiDisplayEnumerator::getLastEnumerationTime() const {
+    return lastEnumerationDuration_;
+}
+
+size_t MultiDisplayEnumerator::getWindowCount() const {
+    return cachedWindows_.size();
+}
+
+std::string MultiDisplayEnumerator::getPlatformInfo() const {
+    std::ostringstream oss;
+    oss << "Linux X11 Multi-Display Enumerator (Displays:";
+    for (const auto& display : displays_) {
+        oss << " " << display->name;
+    }
+    oss << ")";
+    return oss.str();
+}
+
+uint64_t MultiDisplayEnumerator::getServerRequestCount() const {
+    uint64_t total = 0;
+    for (const auto& display : displays_) {
+        total += display->enumerator->getServerRequestCount();
+    }
+    return total;
+}
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
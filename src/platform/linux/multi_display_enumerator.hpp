@@ -0,0 +1,120 @@
+#pragma once
+
+#include "x11_enumerator.hpp"
+#include "platform_config.h"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include "../../daemon/task_worker.hpp"
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WindowManager {
+
+/**
+ * Enumerates several X displays as one window list
+ * Every display gets its own X11Enumerator (and so its own connections) driven by
+ * its own worker thread; enumerations run in parallel and are merged in display
+ * order, so a refresh takes as long as the slowest display rather than the sum.
+ * Handles and workspace ids are display-qualified (":1/3a00004"), which routes
+ * focus, validation and workspace switches back to the right display. Unqualified
+ * handles address the first display. Of the displays' current workspaces only the
+ * focused window's display's counts as current (the first display's while nothing has focus).
+ */
+class MultiDisplayEnumerator : public WindowEnumerator {
+public:
+    static constexpr char HANDLE_SEPARATOR = '/';
+
+    explicit MultiDisplayEnumerator(const std::vector<std::string>& displayNames);
+    ~MultiDisplayEnumerator() override;
+
+    // Non-copyable, non-moveable (owns one worker thread per display)
+    MultiDisplayEnumerator(const MultiDisplayEnumerator&) = delete;
+    MultiDisplayEnumerator& operator=(const MultiDisplayEnumerator&) = delete;
+    MultiDisplayEnumerator(MultiDisplayEnumerator&&) = delete;
+    MultiDisplayEnumerator& operator=(MultiDisplayEnumerator&&) = delete;
+
+    // "<display>/<id>" and back; splitQualified() is false for unqualified ids (`local` = the id)
+    static std::string qualify(const std::string& display, const std::string& id);
+    static bool splitQualified(const std::string& qualifiedId, std::string& display, std::string& local);
+
+    // WindowEnumerator interface implementation
+    std::vector<WindowInfo> enumerateWindows() override;
+    bool refreshWindowList() override;
+    std::optional<WindowInfo> getWindowInfo(const std::string& handle) override;
+    bool focusWindow(const std::string& handle) override;
+    bool isWindowValid(const std::string& handle) override;
+
+    std::vector<WorkspaceInfo> enumerateWorkspaces() override;
+    std::optional<WorkspaceInfo> getCurrentWorkspace() override; // On the focused window's display
+    std::vector<WindowInfo> enumerateAllWorkspaceWindows() override;
+    std::vector<WindowInfo> getWindowsOnWorkspace(const std::string& workspaceId) override;
+    std::optional<WindowInfo> getEnhancedWindowInfo(const std::string& handle) override;
+    bool isWorkspaceSupported() const override;
+    std::optional<WindowInfo> getFocusedWindow() override; // First display with a focused window
+
+    bool switchToWorkspace(const std::string& workspaceId) override;
+    bool canSwitchWorkspaces() const override;
+
+    // Notifications of every display, multiplexed through one epoll fd
+    bool supportsChangeNotifications() const override;
+    bool waitForChanges(std::chrono::milliseconds timeout) override;
+    void interruptWaitForChanges() override;
+    int getChangeNotificationFd() const override;
+    bool processChangeNotifications() override;
+    void setChangeCoalescingLatency(std::chrono::milliseconds latency) override;
+    std::optional<std::chrono::steady_clock::time_point> getNextChangeDeadline() const override;
+    ChangeCoalescingStats getChangeCoalescingStats() const override;
+
+    std::optional<WindowThumbnail> captureThumbnail(const std::string& handle,
+                                                    unsigned int maxWidth, unsigned int maxHeight) override;
+
+    std::chrono::milliseconds getLastEnumerationTime() const override;
+    size_t getWindowCount() const override;
+    std::string getPlatformInfo() const override;
+    uint64_t getServerRequestCount() const override;
+
+private:
+    struct DisplayConnection {
+        std::string name;
+        std::unique_ptr<X11Enumerator> enumerator; // Only used on `worker`
+        std::unique_ptr<TaskWorker> worker;        // Declared last: joined before the enumerator goes
+    };
+
+    // Per-display answers merged by enumerateWorkspaces() / getCurrentWorkspace()
+    struct DisplayState {
+        bool hasFocus = false;                  // Has a focused window
+        std::vector<WorkspaceInfo> workspaces;  // When collected with workspaces
+        std::optional<WorkspaceInfo> current;   // Otherwise
+    };
+
+    std::vector<std::unique_ptr<DisplayConnection>> displays_;
+    int epollFd_;
+    int wakeFd_; // eventfd ending waitForChanges() early; kept out of the exported epoll set
+    mutable std::once_flag epollRegistered_;
+
+    // Adds every display's event connection to epollFd_, opening them (once)
+    void registerChangeNotifications() const;
+
+    // Runs `task` on the display's worker thread
+    template <typename Result>
+    std::future<Result> submit(DisplayConnection& display, std::function<Result(X11Enumerator&)> task);
+
+    // Display addressed by a qualified id; `local` receives the id without the prefix
+    DisplayConnection* resolve(const std::string& qualifiedId, std::string& local);
+
+    // Queries every display in parallel; rethrows the first failure once all have finished
+    std::vector<DisplayState> collectDisplayStates(bool withWorkspaces);
+    static size_t focusedDisplayIndex(const std::vector<DisplayState>& states);
+
+    static void qualifyWindow(const std::string& display, WindowInfo& window);
+    static void qualifyWorkspace(const std::string& display, WorkspaceInfo& workspace);
+};
+
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
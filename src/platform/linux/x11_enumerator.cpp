@@ -6,11 +6,110 @@
 #include <sstream>
 #include <fstream>
 #include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+
+#ifdef HAVE_XCOMPOSITE
+#include <X11/extensions/Xcomposite.h>
+#endif
+#ifdef HAVE_XSHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
 
 namespace WindowManager {
 
-X11Enumerator::X11Enumerator()
-    : display_(nullptr)
+namespace {
+
+// Watched windows can disappear at any time; a late XSelectInput on a destroyed
+// window must not take the process down through the default error handler.
+// Installed once per process and never swapped, since Xlib has a single handler.
+XErrorHandler previousErrorHandler = nullptr;
+std::once_flag errorHandlerOnce;
+
+// Errors on a capture connection (unviewable windows, missing extensions, remote
+// displays without MIT-SHM) are recorded and turned into a failed capture instead.
+// Keyed by connection: captures on several displays run concurrently.
+std::mutex errorTrapMutex;
+std::unordered_map<Display*, bool> errorTraps; // Trapped connection -> error raised
+
+int ignoreBadWindowErrors(Display* display, XErrorEvent* error) {
+    {
+        std::lock_guard<std::mutex> lock(errorTrapMutex);
+        auto trap = errorTraps.find(display);
+        if (trap != errorTraps.end()) {
+            trap->second = true;
+            return 0;
+        }
+    }
+    if (error->error_code == BadWindow) {
+        return 0;
+    }
+    return previousErrorHandler ? previousErrorHandler(display, error) : 0;
+}
+
+void installErrorHandler() {
+    std::call_once(errorHandlerOnce, [] { previousErrorHandler = XSetErrorHandler(ignoreBadWindowErrors); });
+}
+
+// Starts trapping errors on `display`, or clears the flag of a trap already set
+void resetErrorTrap(Display* display) {
+    std::lock_guard<std::mutex> lock(errorTrapMutex);
+    errorTraps[display] = false;
+}
+
+bool errorTrapped(Display* display) {
+    std::lock_guard<std::mutex> lock(errorTrapMutex);
+    auto trap = errorTraps.find(display);
+    return trap != errorTraps.end() && trap->second;
+}
+
+void releaseErrorTrap(Display* display) {
+    std::lock_guard<std::mutex> lock(errorTrapMutex);
+    errorTraps.erase(display);
+}
+
+// _NET_DESKTOP_NAMES: NUL-separated UTF-8 strings; empty entries are skipped
+std::vector<std::string> splitDesktopNames(const std::string& desktopNames) {
+    std::vector<std::string> names;
+    size_t start = 0;
+    for (size_t i = 0; i < desktopNames.length(); ++i) {
+        if (desktopNames[i] == '\0') {
+            if (i > start) {
+                names.push_back(desktopNames.substr(start, i - start));
+            }
+            start = i + 1;
+        }
+    }
+    // Add last name if no trailing null
+    if (start < desktopNames.length()) {
+        names.push_back(desktopNames.substr(start));
+    }
+    return names;
+}
+
+// Expands one colour channel of a TrueColor pixel to 8 bits
+uint32_t extractChannel(unsigned long pixel, unsigned long mask) {
+    if (mask == 0) {
+        return 0;
+    }
+    int shift = 0;
+    while (((mask >> shift) & 1UL) == 0) {
+        ++shift;
+    }
+    unsigned long maxValue = mask >> shift;
+    return static_cast<uint32_t>(((pixel & mask) >> shift) * 255UL / maxValue);
+}
+
+} // namespace
+
+X11Enumerator::X11Enumerator(const std::string& displayName)
+    : displayName_(displayName)
+    , display_(nullptr)
     , rootWindow_(0)
     , netWmNameAtom_(0)
     , netWmPidAtom_(0)
@@ -21,18 +120,51 @@ X11Enumerator::X11Enumerator()
     , netDesktopNamesAtom_(0)
     , netCurrentDesktopAtom_(0)
     , netWmDesktopAtom_(0)
-    , netActiveWindowAtom_(0) {
+    , netActiveWindowAtom_(0)
+    , netClientListAtom_(0)
+    , hasFullEnumeration_(false)
+    , activeWindow_(0)
+    , currentDesktop_(0)
+    , eventDisplay_(nullptr)
+    , eventsOpen_(false)
+    , eventsFailed_(false)
+    , wakeFd_(-1)
+    , eventsDrained_(false)
+    , workspaceTableEpoch_(0)
+    , workspaceEpoch_(1)
+    , notificationsConsumed_(false)
+    , captureDisplay_(nullptr)
+    , compositeAvailable_(false)
+    , shmAvailable_(false)
+#ifdef HAVE_XSHM
+    , captureShm_{}
+    , captureShmSize_(0)
+#endif
+{
     initializeX11();
     initializeEWMH();
+
+    // Cheap, unlike the event connection: interrupts work before the first wait
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
 }
 
 X11Enumerator::~X11Enumerator() {
+    cleanupCapture();
+    cleanupChangeNotifications();
     cleanupX11();
 }
 
 void X11Enumerator::initializeX11() {
-    display_ = XOpenDisplay(nullptr);
+    // Connections are used from several threads (refresh, notifications, captures, focus);
+    // Xlib needs this before its first connection
+    static std::once_flag threadsInitialized;
+    std::call_once(threadsInitialized, []() { XInitThreads(); });
+
+    display_ = XOpenDisplay(displayName_.empty() ? nullptr : displayName_.c_str());
     if (!display_) {
+        if (!displayName_.empty()) {
+            throw WindowEnumerationException("Unable to open X11 display " + displayName_ + ".");
+        }
         throw WindowEnumerationException("Unable to open X11 display. Check DISPLAY environment variable.");
     }
 
@@ -62,6 +194,7 @@ void X11Enumerator::initializeEWMH() {
     netCurrentDesktopAtom_ = XInternAtom(display_, "_NET_CURRENT_DESKTOP", False);
     netWmDesktopAtom_ = XInternAtom(display_, "_NET_WM_DESKTOP", False);
     netActiveWindowAtom_ = XInternAtom(display_, "_NET_ACTIVE_WINDOW", False);
+    netClientListAtom_ = XInternAtom(display_, "_NET_CLIENT_LIST", False);
 
     // Check if window manager supports EWMH
     Atom supportedAtom = XInternAtom(display_, "_NET_SUPPORTED", False);
@@ -74,7 +207,16 @@ std::vector<WindowInfo> X11Enumerator::enumerateWindows() {
     std::vector<WindowInfo> windows;
 
     try {
-        enumerateWindowsRecursive(rootWindow_, windows);
+        if (canEnumerateIncrementally(start)) {
+            enumerateIncrementally();
+        } else {
+            // Read before the walk: windows admitted while the connection was closed are not watched
+            bool watched = eventsOpen_;
+            enumerateFully();
+            lastFullEnumeration_ = start;
+            hasFullEnumeration_ = watched;
+        }
+        windows = collectCachedWindows();
     } catch (const std::exception& e) {
         throw WindowEnumerationException("X11 enumeration failed: " + std::string(e.what()));
     }
@@ -87,7 +229,93 @@ std::vector<WindowInfo> X11Enumerator::enumerateWindows() {
     return windows;
 }
 
-void X11Enumerator::enumerateWindowsRecursive(Window window, std::vector<WindowInfo>& windows) {
+bool X11Enumerator::canEnumerateIncrementally(std::chrono::steady_clock::time_point now) {
+    // Without a consumer draining notifications the dirty bits would never be set
+    if (!hasFullEnumeration_ || now - lastFullEnumeration_ >= FULL_RECONCILE_INTERVAL) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pendingChangesMutex_);
+    return eventsDrained_;
+}
+
+void X11Enumerator::enumerateFully() {
+    takePendingChanges(); // Everything is fetched again anyway
+    refreshRootProperties(RootAll);
+
+    std::unordered_map<Window, CachedWindow> cache;
+    std::vector<Window> order;
+    std::unordered_map<Window, uint32_t> candidates;
+    walkWindowTree(rootWindow_, 0, false, cache, order, candidates);
+
+    windowCache_ = std::move(cache);
+    windowOrder_ = std::move(order);
+    candidates_ = std::move(candidates);
+}
+
+void X11Enumerator::enumerateIncrementally() {
+    PendingChanges changes = takePendingChanges();
+    refreshRootProperties(changes.root);
+
+    // Re-fetch only dirty properties; frame moves and (un)maps apply to the clients inside
+    if (!changes.windows.empty()) {
+        for (auto it = windowCache_.begin(); it != windowCache_.end();) {
+            uint32_t properties = 0;
+            auto own = changes.windows.find(it->first);
+            if (own != changes.windows.end()) {
+                properties |= own->second;
+            }
+            auto frame = changes.windows.find(it->second.topLevel);
+            if (frame != changes.windows.end()) {
+                properties |= frame->second & (DirtyGeometry | DirtyVisibility);
+            }
+
+            if (properties != 0) {
+                try {
+                    fetchWindowProperties(it->first, it->second, properties);
+                } catch (const WindowManagerException&) {
+                    it = windowCache_.erase(it); // Destroyed since; DestroyNotify is on its way
+                    continue;
+                }
+
+                // A window whose title emptied, pid vanished or that shrank to 0x0 leaves the
+                // list now rather than at the next reconcile; it is already watched
+                uint32_t retryOn = 0;
+                if ((properties & (DirtyName | DirtyPid | DirtyGeometry)) && !stillAdmitted(it->second, retryOn)) {
+                    candidates_[it->first] = retryOn;
+                    it = windowCache_.erase(it);
+                    continue;
+                }
+            }
+            ++it;
+        }
+    }
+
+    // A rejected window gained what it lacked (typically a title set after mapping)
+    if (!changes.structure) {
+        for (const auto& [window, properties] : changes.windows) {
+            auto candidate = candidates_.find(window);
+            if (candidate != candidates_.end() && (properties & candidate->second)) {
+                changes.structure = true;
+                break;
+            }
+        }
+    }
+
+    // New or reparented windows: walk the tree again, keeping everything already known
+    if (changes.structure) {
+        std::unordered_map<Window, CachedWindow> cache;
+        std::vector<Window> order;
+        std::unordered_map<Window, uint32_t> candidates;
+        walkWindowTree(rootWindow_, 0, true, cache, order, candidates);
+        windowCache_ = std::move(cache);
+        windowOrder_ = std::move(order);
+        candidates_ = std::move(candidates);
+    }
+}
+
+void X11Enumerator::walkWindowTree(Window window, Window topLevel, bool reuseCached,
+                                   std::unordered_map<Window, CachedWindow>& cache, std::vector<Window>& order,
+                                   std::unordered_map<Window, uint32_t>& candidates) {
     Window root, parent;
     Window* children;
     unsigned int nchildren;
@@ -98,19 +326,33 @@ void X11Enumerator::enumerateWindowsRecursive(Window window, std::vector<WindowI
 
     // Process current window if it's not the root window
     if (window != rootWindow_) {
-        try {
-            WindowInfo info = createWindowInfo(window);
-            if (info.isValid() && !info.title.empty()) {
-                windows.push_back(info);
+        auto cached = reuseCached ? windowCache_.find(window) : windowCache_.end();
+        if (cached != windowCache_.end()) {
+            cached->second.topLevel = topLevel;
+            cache.emplace(window, std::move(cached->second));
+            order.push_back(window);
+        } else {
+            try {
+                CachedWindow entry;
+                entry.topLevel = topLevel;
+                uint32_t retryOn = 0;
+                if (admitWindow(window, entry, retryOn)) {
+                    cache.emplace(window, std::move(entry));
+                    order.push_back(window);
+                } else {
+                    candidates.emplace(window, retryOn);
+                }
+                queueWindowWatch(window);
+            } catch (const WindowManagerException&) {
+                // Continue with other windows even if one fails
             }
-        } catch (const WindowManagerException&) {
-            // Continue with other windows even if one fails
         }
     }
 
     // Recursively process children
     for (unsigned int i = 0; i < nchildren; ++i) {
-        enumerateWindowsRecursive(children[i], windows);
+        walkWindowTree(children[i], window == rootWindow_ ? children[i] : topLevel, reuseCached, cache, order,
+                       candidates);
     }
 
     if (children) {
@@ -118,6 +360,124 @@ void X11Enumerator::enumerateWindowsRecursive(Window window, std::vector<WindowI
     }
 }
 
+bool X11Enumerator::admitWindow(Window window, CachedWindow& entry, uint32_t& retryOn) {
+    // Most of the tree is frames and decorations without a title or pid: reject
+    // those before paying for the remaining properties
+    entry.info.handle = handleToString(window);
+    fetchWindowProperties(window, entry, DirtyName);
+    if (entry.info.title.empty()) {
+        retryOn = DirtyName;
+        return false;
+    }
+    fetchWindowProperties(window, entry, DirtyPid);
+    if (entry.info.processId == 0) {
+        retryOn = DirtyPid;
+        return false;
+    }
+    fetchWindowProperties(window, entry, DirtyAll & ~(DirtyName | DirtyPid));
+    retryOn = DirtyGeometry;
+    return entry.info.hasValidDimensions();
+}
+
+bool X11Enumerator::stillAdmitted(const CachedWindow& entry, uint32_t& retryOn) const {
+    // admitWindow()'s checks, on properties that are already fetched
+    if (entry.info.title.empty()) {
+        retryOn = DirtyName;
+        return false;
+    }
+    if (entry.info.processId == 0) {
+        retryOn = DirtyPid;
+        return false;
+    }
+    retryOn = DirtyGeometry;
+    return entry.info.hasValidDimensions();
+}
+
+void X11Enumerator::fetchWindowProperties(Window window, CachedWindow& entry, uint32_t properties) {
+    WindowInfo& info = entry.info;
+
+    if (properties & DirtyName) {
+        info.title = getWindowTitle(window);
+    }
+    if (properties & DirtyGeometry) {
+        getWindowGeometry(window, info.x, info.y, info.width, info.height);
+    }
+    if (properties & DirtyVisibility) {
+        info.isVisible = isWindowVisible(window);
+    }
+    if (properties & DirtyPid) {
+        unsigned long pid = getWindowPid(window);
+        info.processId = static_cast<unsigned int>(pid);
+        info.ownerName = getProcessName(pid);
+    }
+    if (properties & DirtyDesktop) {
+        entry.desktop = ewmhSupported_ ? getPropertyLong(window, netWmDesktopAtom_) : 0;
+    }
+    if (properties & DirtyState) {
+        entry.hidden = isWindowHidden(window);
+    }
+}
+
+void X11Enumerator::refreshRootProperties(uint32_t properties) {
+    if (!ewmhSupported_) {
+        return;
+    }
+    if (properties & RootActiveWindow) {
+        activeWindow_ = static_cast<Window>(getPropertyLong(rootWindow_, netActiveWindowAtom_));
+    }
+    if (properties & RootCurrentDesktop) {
+        currentDesktop_ = getCurrentDesktopIndex();
+    }
+    if (properties & RootDesktopNames) {
+        desktopNames_ = splitDesktopNames(getProperty(rootWindow_, netDesktopNamesAtom_));
+    }
+}
+
+void X11Enumerator::deriveWindowInfo(Window window, CachedWindow& entry) const {
+    WindowInfo& info = entry.info;
+
+    // T026: Linux workspace detection using _NET_WM_DESKTOP
+    // (0xFFFFFFFF means the window is on all desktops)
+    bool onAllDesktops = ewmhSupported_ && entry.desktop == 0xFFFFFFFF;
+    if (!ewmhSupported_ || (!onAllDesktops && entry.desktop > 100)) {
+        info.workspaceId = "0";
+    } else {
+        info.workspaceId = onAllDesktops ? "all" : std::to_string(entry.desktop);
+    }
+    info.workspaceName = getWorkspaceName(info.workspaceId);
+    info.isOnCurrentWorkspace = !ewmhSupported_ || onAllDesktops ||
+                                static_cast<int>(entry.desktop) == currentDesktop_;
+
+    // T028: hidden (minimized) beats focused beats other-desktop
+    if (entry.hidden) {
+        info.state = WindowState::Minimized;
+    } else if (ewmhSupported_ && activeWindow_ == window) {
+        info.state = WindowState::Focused;
+    } else if (!info.isOnCurrentWorkspace) {
+        info.state = WindowState::Hidden;
+    } else {
+        info.state = WindowState::Normal;
+    }
+    info.isFocused = (info.state == WindowState::Focused);
+    info.isMinimized = (info.state == WindowState::Minimized);
+}
+
+std::vector<WindowInfo> X11Enumerator::collectCachedWindows() {
+    std::vector<WindowInfo> windows;
+    windows.reserve(windowOrder_.size());
+    for (Window window : windowOrder_) {
+        auto it = windowCache_.find(window);
+        if (it == windowCache_.end()) {
+            continue;
+        }
+        deriveWindowInfo(window, it->second);
+        if (it->second.info.isValid() && !it->second.info.title.empty()) {
+            windows.push_back(it->second.info);
+        }
+    }
+    return windows;
+}
+
 bool X11Enumerator::refreshWindowList() {
     try {
         enumerateWindows();
@@ -156,8 +516,8 @@ bool X11Enumerator::focusWindow(const std::string& handle) {
             // Window is on a different desktop - attempt to switch
             std::string targetWorkspaceId = std::to_string(windowDesktop);
             if (switchToWorkspace(targetWorkspaceId)) {
-                // Wait for workspace switch to complete
-                usleep(200000); // 200ms wait
+                // Focus once the window manager reports the desktop, not after a fixed delay
+                waitForCurrentDesktop(windowDesktop, DESKTOP_SWITCH_TIMEOUT);
             }
         }
     }
@@ -211,18 +571,14 @@ bool X11Enumerator::isWindowValid(const std::string& handle) {
     Window* children = nullptr;
     unsigned int nchildren;
 
-    // Set error handler to catch BadWindow errors
-    XErrorHandler oldHandler = XSetErrorHandler([](Display*, XErrorEvent* error) -> int {
-        return (error->error_code == BadWindow) ? 0 : 1;
-    });
+    // BadWindow for a stale handle is ignored by the process-wide handler
+    installErrorHandler();
 
     int queryResult = XQueryTree(display_, window, &root, &parent, &children, &nchildren);
     if (children) {
         XFree(children);
     }
 
-    XSetErrorHandler(oldHandler); // Restore original error handler
-
     if (queryResult == 0) {
         return false; // Window doesn't exist in X11 hierarchy
     }
@@ -333,37 +689,19 @@ std::string X11Enumerator::getPlatformInfo() const {
     return oss.str();
 }
 
-WindowInfo X11Enumerator::createWindowInfo(Window window) {
-    WindowInfo info;
-
-    // Set handle
-    info.handle = handleToString(window);
-
-    // Get window title
-    info.title = getWindowTitle(window);
-
-    // Get window geometry
-    getWindowGeometry(window, info.x, info.y, info.width, info.height);
-
-    // Get visibility state
-    info.isVisible = isWindowVisible(window);
-
-    // Get process information
-    unsigned long pid = getWindowPid(window);
-    info.processId = static_cast<unsigned int>(pid);
-    info.ownerName = getProcessName(pid);
-
-    // NEW: Add workspace information (T027)
-    info.workspaceId = getWindowWorkspaceId(window);
-    info.workspaceName = getWorkspaceName(info.workspaceId);
-    info.isOnCurrentWorkspace = isWindowOnCurrentWorkspace(window);
+uint64_t X11Enumerator::getServerRequestCount() const {
+    // Every query the enumerator issues waits for its reply, so requests equal round trips
+    return display_ ? static_cast<uint64_t>(XNextRequest(display_)) - 1 : 0;
+}
 
-    // NEW: Add enhanced state information (T028)
-    info.state = getWindowState(window);
-    info.isFocused = (info.state == WindowState::Focused);
-    info.isMinimized = (info.state == WindowState::Minimized);
+WindowInfo X11Enumerator::createWindowInfo(Window window) {
+    refreshRootProperties(RootAll);
 
-    return info;
+    CachedWindow entry;
+    entry.info.handle = handleToString(window);
+    fetchWindowProperties(window, entry, DirtyAll);
+    deriveWindowInfo(window, entry);
+    return entry.info;
 }
 
 std::string X11Enumerator::getWindowTitle(Window window) {
@@ -433,6 +771,15 @@ bool X11Enumerator::isWindowVisible(Window window) {
     return attrs.map_state == IsViewable;
 }
 
+bool X11Enumerator::isWindowHidden(Window window) {
+    // Check if window is hidden/minimized via EWMH
+    if (!ewmhSupported_) {
+        return false;
+    }
+    std::string state = getProperty(window, netWmStateAtom_);
+    return state.find("_NET_WM_STATE_HIDDEN") != std::string::npos;
+}
+
 std::string X11Enumerator::getProperty(Window window, Atom property) {
     Atom actual_type;
     int actual_format;
@@ -488,6 +835,31 @@ std::string X11Enumerator::handleToString(Window window) {
 // NEW: Workspace/EWMH implementation (T024-T028)
 
 std::vector<WorkspaceInfo> X11Enumerator::enumerateWorkspaces() {
+    // Served without round trips while desktop changes are being observed
+    uint64_t epoch = workspaceEpoch_.load();
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(workspaceMutex_);
+        if (notificationsConsumed_ && workspaceTableEpoch_ == epoch &&
+            now - workspaceTableBuilt_ < FULL_RECONCILE_INTERVAL) {
+            return workspaceTable_;
+        }
+    }
+
+    // Built from properties read after `epoch`; a change arriving meanwhile bumps the
+    // epoch again, so a stale table is never marked current
+    auto workspaces = buildWorkspaceTable();
+    {
+        std::lock_guard<std::mutex> lock(workspaceMutex_);
+        workspaceTable_ = workspaces;
+        workspaceTableEpoch_ = epoch;
+        workspaceTableBuilt_ = now;
+    }
+    cachedWorkspaces_ = workspaces;
+    return workspaces;
+}
+
+std::vector<WorkspaceInfo> X11Enumerator::buildWorkspaceTable() {
     // T025: EWMH workspace enumeration using _NET_NUMBER_OF_DESKTOPS
     std::vector<WorkspaceInfo> workspaces;
 
@@ -495,7 +867,6 @@ std::vector<WorkspaceInfo> X11Enumerator::enumerateWorkspaces() {
         // Create default workspace when EWMH not supported
         WorkspaceInfo defaultWorkspace("0", "Desktop", 0, true);
         workspaces.push_back(defaultWorkspace);
-        cachedWorkspaces_ = workspaces;
         return workspaces;
     }
 
@@ -509,25 +880,7 @@ std::vector<WorkspaceInfo> X11Enumerator::enumerateWorkspaces() {
     int currentDesktop = getCurrentDesktopIndex();
 
     // Get desktop names if available
-    std::string desktopNames = getProperty(rootWindow_, netDesktopNamesAtom_);
-    std::vector<std::string> names;
-
-    // Parse null-separated desktop names
-    if (!desktopNames.empty()) {
-        size_t start = 0;
-        for (size_t i = 0; i < desktopNames.length(); ++i) {
-            if (desktopNames[i] == '\0') {
-                if (i > start) {
-                    names.push_back(desktopNames.substr(start, i - start));
-                }
-                start = i + 1;
-            }
-        }
-        // Add last name if no trailing null
-        if (start < desktopNames.length()) {
-            names.push_back(desktopNames.substr(start));
-        }
-    }
+    std::vector<std::string> names = splitDesktopNames(getProperty(rootWindow_, netDesktopNamesAtom_));
 
     // Create WorkspaceInfo objects
     for (unsigned long i = 0; i < numDesktops; ++i) {
@@ -541,7 +894,6 @@ std::vector<WorkspaceInfo> X11Enumerator::enumerateWorkspaces() {
         workspaces.push_back(workspace);
     }
 
-    cachedWorkspaces_ = workspaces;
     return workspaces;
 }
 
@@ -624,28 +976,7 @@ std::optional<WindowInfo> X11Enumerator::getFocusedWindow() {
 
 // Helper methods implementation
 
-std::string X11Enumerator::getWindowWorkspaceId(Window window) {
-    // T026: Linux workspace detection using _NET_WM_DESKTOP
-    if (!ewmhSupported_) {
-        return "0"; // Default workspace
-    }
-
-    long desktop = static_cast<long>(getPropertyLong(window, netWmDesktopAtom_));
-
-    // Special value 0xFFFFFFFF means window is on all desktops
-    if (desktop == 0xFFFFFFFF) {
-        return "all";
-    }
-
-    // Negative values or very large values are invalid
-    if (desktop < 0 || desktop > 100) {
-        return "0";
-    }
-
-    return std::to_string(desktop);
-}
-
-std::string X11Enumerator::getWorkspaceName(const std::string& workspaceId) {
+std::string X11Enumerator::getWorkspaceName(const std::string& workspaceId) const {
     if (workspaceId == "all") {
         return "All Desktops";
     }
@@ -657,28 +988,10 @@ std::string X11Enumerator::getWorkspaceName(const std::string& workspaceId) {
     try {
         int index = std::stoi(workspaceId);
 
-        // Try to get actual desktop name from EWMH
-        if (ewmhSupported_) {
-            std::string desktopNames = getProperty(rootWindow_, netDesktopNamesAtom_);
-            if (!desktopNames.empty()) {
-                std::vector<std::string> names;
-                size_t start = 0;
-                for (size_t i = 0; i < desktopNames.length(); ++i) {
-                    if (desktopNames[i] == '\0') {
-                        if (i > start) {
-                            names.push_back(desktopNames.substr(start, i - start));
-                        }
-                        start = i + 1;
-                    }
-                }
-                if (start < desktopNames.length()) {
-                    names.push_back(desktopNames.substr(start));
-                }
-
-                if (index >= 0 && index < static_cast<int>(names.size()) && !names[index].empty()) {
-                    return names[index];
-                }
-            }
+        // Actual desktop name from EWMH, as of the last root property refresh
+        if (ewmhSupported_ && index >= 0 && index < static_cast<int>(desktopNames_.size()) &&
+            !desktopNames_[index].empty()) {
+            return desktopNames_[index];
         }
 
         return "Desktop " + std::to_string(index + 1);
@@ -687,47 +1000,6 @@ std::string X11Enumerator::getWorkspaceName(const std::string& workspaceId) {
     }
 }
 
-bool X11Enumerator::isWindowOnCurrentWorkspace(Window window) {
-    if (!ewmhSupported_) {
-        return true; // Assume yes if EWMH not supported
-    }
-
-    int currentDesktop = getCurrentDesktopIndex();
-    int windowDesktop = getWindowDesktopIndex(window);
-
-    // Window on all desktops is always on current workspace
-    if (windowDesktop == 0xFFFFFFFF) {
-        return true;
-    }
-
-    return windowDesktop == currentDesktop;
-}
-
-WindowState X11Enumerator::getWindowState(Window window) {
-    // Check if window is hidden/minimized via EWMH
-    if (ewmhSupported_) {
-        std::string state = getProperty(window, netWmStateAtom_);
-        if (state.find("_NET_WM_STATE_HIDDEN") != std::string::npos) {
-            return WindowState::Minimized;
-        }
-    }
-
-    // Check if window is the active window
-    if (ewmhSupported_) {
-        Window activeWindow = static_cast<Window>(getPropertyLong(rootWindow_, netActiveWindowAtom_));
-        if (activeWindow == window) {
-            return WindowState::Focused;
-        }
-    }
-
-    // Check if window is on current workspace
-    if (!isWindowOnCurrentWorkspace(window)) {
-        return WindowState::Hidden;
-    }
-
-    return WindowState::Normal;
-}
-
 int X11Enumerator::getCurrentDesktopIndex() {
     if (!ewmhSupported_) {
         return 0;
@@ -746,6 +1018,29 @@ int X11Enumerator::getWindowDesktopIndex(Window window) {
     return static_cast<int>(desktop);
 }
 
+bool X11Enumerator::waitForCurrentDesktop(int desktop, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    // The root's _NET_CURRENT_DESKTOP PropertyNotify bumps workspaceEpoch_ as soon as the
+    // notification thread drains it. When nobody drains (e.g. the caller is that thread),
+    // the short slices fall back to re-reading the property on our own connection.
+    while (true) {
+        uint64_t epoch = workspaceEpoch_.load();
+        if (getCurrentDesktopIndex() == desktop) {
+            return true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+
+        std::unique_lock<std::mutex> lock(workspaceMutex_);
+        auto slice = std::min<std::chrono::steady_clock::duration>(deadline - now, DESKTOP_SWITCH_POLL);
+        workspaceChanged_.wait_for(lock, slice, [&] { return workspaceEpoch_.load() != epoch; });
+    }
+}
+
 // NEW: Workspace switching operations (for cross-workspace focus)
 bool X11Enumerator::switchToWorkspace(const std::string& workspaceId) {
     // Implementation for User Story 2 - Linux X11 workspace switching
@@ -802,6 +1097,515 @@ bool X11Enumerator::canSwitchWorkspaces() const {
     return ewmhSupported_ && display_ != nullptr;
 }
 
+// Change notifications for event-driven refresh
+
+void X11Enumerator::initializeChangeNotifications() const {
+    // A second connection keeps event traffic away from the query connection
+    eventDisplay_ = XOpenDisplay(DisplayString(display_));
+    if (!eventDisplay_) {
+        eventsFailed_ = true; // Callers fall back to polling
+        return;
+    }
+
+    installErrorHandler();
+
+    // Root window: EWMH state (_NET_CLIENT_LIST, _NET_ACTIVE_WINDOW, desktops)
+    // and top-level create/destroy/map/unmap/configure
+    XSelectInput(eventDisplay_, DefaultRootWindow(eventDisplay_),
+                 PropertyChangeMask | SubstructureNotifyMask);
+    XFlush(eventDisplay_);
+
+    // Windows enumerated so far were not watched: the next enumeration walks them again
+    eventsOpen_ = true;
+}
+
+bool X11Enumerator::ensureChangeNotifications() const {
+    std::call_once(eventDisplayOnce_, [this]() { initializeChangeNotifications(); });
+    return eventDisplay_ != nullptr;
+}
+
+void X11Enumerator::cleanupChangeNotifications() {
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+        wakeFd_ = -1;
+    }
+    if (eventDisplay_) {
+        XCloseDisplay(eventDisplay_);
+        eventDisplay_ = nullptr;
+    }
+}
+
+bool X11Enumerator::supportsChangeNotifications() const {
+    return display_ != nullptr && !eventsFailed_;
+}
+
+void X11Enumerator::queueWindowWatch(Window window) {
+    if (!eventsOpen_) {
+        return; // Nobody consumes events; the first full walk after opening queues it
+    }
+
+    std::lock_guard<std::mutex> lock(watchMutex_);
+    if (watchedWindows_.insert(window).second) {
+        pendingWatches_.push_back(window);
+    }
+}
+
+void X11Enumerator::applyPendingWatches() {
+    std::vector<Window> windows;
+    {
+        std::lock_guard<std::mutex> lock(watchMutex_);
+        windows.swap(pendingWatches_);
+    }
+
+    // Client windows: title/state/desktop property changes and geometry
+    for (Window window : windows) {
+        XSelectInput(eventDisplay_, window, PropertyChangeMask | StructureNotifyMask);
+    }
+    if (!windows.empty()) {
+        XFlush(eventDisplay_);
+
+        // Changes between enumeration and XSelectInput produced no event: fetch once more
+        std::lock_guard<std::mutex> lock(pendingChangesMutex_);
+        for (Window window : windows) {
+            pendingChanges_.windows[window] |= DirtyAll;
+        }
+    }
+}
+
+bool X11Enumerator::isRelevantChange(const XEvent& event) const {
+    switch (event.type) {
+        case CreateNotify:
+        case DestroyNotify:
+        case MapNotify:
+        case UnmapNotify:
+        case ReparentNotify:
+        case ConfigureNotify:
+            return true;
+        case PropertyNotify: {
+            Atom atom = event.xproperty.atom;
+            return atom == netWmNameAtom_ || atom == XA_WM_NAME ||
+                   atom == netWmStateAtom_ || atom == netWmDesktopAtom_ || atom == netWmPidAtom_ ||
+                   atom == netActiveWindowAtom_ || atom == netCurrentDesktopAtom_ ||
+                   atom == netNumberOfDesktopsAtom_ || atom == netDesktopNamesAtom_ ||
+                   atom == netClientListAtom_;
+        }
+        default:
+            return false;
+    }
+}
+
+bool X11Enumerator::isWorkspaceChange(const XEvent& event) const {
+    if (event.type != PropertyNotify || event.xproperty.window != DefaultRootWindow(eventDisplay_)) {
+        return false;
+    }
+    Atom atom = event.xproperty.atom;
+    return atom == netNumberOfDesktopsAtom_ || atom == netCurrentDesktopAtom_ || atom == netDesktopNamesAtom_;
+}
+
+void X11Enumerator::recordChange(const XEvent& event, PendingChanges& changes) const {
+    switch (event.type) {
+        case CreateNotify:
+        case DestroyNotify:
+        case ReparentNotify:
+            changes.structure = true;
+            break;
+        case MapNotify:
+            changes.windows[event.xmap.window] |= DirtyVisibility;
+            break;
+        case UnmapNotify:
+            changes.windows[event.xunmap.window] |= DirtyVisibility;
+            break;
+        case ConfigureNotify:
+            changes.windows[event.xconfigure.window] |= DirtyGeometry;
+            break;
+        case PropertyNotify: {
+            Atom atom = event.xproperty.atom;
+            if (event.xproperty.window == DefaultRootWindow(eventDisplay_)) {
+                if (atom == netActiveWindowAtom_) {
+                    changes.root |= RootActiveWindow;
+                } else if (atom == netCurrentDesktopAtom_) {
+                    changes.root |= RootCurrentDesktop;
+                } else if (atom == netDesktopNamesAtom_) {
+                    changes.root |= RootDesktopNames;
+                } else if (atom == netClientListAtom_) {
+                    changes.structure = true;
+                }
+                break;
+            }
+
+            uint32_t& properties = changes.windows[event.xproperty.window];
+            if (atom == netWmNameAtom_ || atom == XA_WM_NAME) {
+                properties |= DirtyName;
+            } else if (atom == netWmStateAtom_) {
+                properties |= DirtyState;
+            } else if (atom == netWmDesktopAtom_) {
+                properties |= DirtyDesktop;
+            } else if (atom == netWmPidAtom_) {
+                properties |= DirtyPid;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+X11Enumerator::PendingChanges X11Enumerator::takePendingChanges() {
+    PendingChanges changes;
+    std::lock_guard<std::mutex> lock(pendingChangesMutex_);
+    std::swap(changes, pendingChanges_);
+    eventsDrained_ = false;
+    return changes;
+}
+
+bool X11Enumerator::drainChangeEvents() {
+    bool changed = false;
+    PendingChanges changes;
+
+    while (XPending(eventDisplay_) > 0) {
+        XEvent event;
+        XNextEvent(eventDisplay_, &event);
+
+        if (event.type == DestroyNotify) {
+            std::lock_guard<std::mutex> lock(watchMutex_);
+            watchedWindows_.erase(event.xdestroywindow.window);
+        }
+
+        if (isWorkspaceChange(event)) {
+            {
+                std::lock_guard<std::mutex> lock(workspaceMutex_);
+                ++workspaceEpoch_;
+            }
+            workspaceChanged_.notify_all();
+        }
+
+        if (isRelevantChange(event)) {
+            // Dirty bits are recorded either way, so any refresh picks up the latest title
+            recordChange(event, changes);
+            bool titleChange = event.type == PropertyNotify &&
+                               (event.xproperty.atom == netWmNameAtom_ || event.xproperty.atom == XA_WM_NAME);
+            if (!titleChange || titleCoalescer_.submit(event.xproperty.window)) {
+                changed = true;
+            }
+        }
+    }
+
+    // Title bursts whose coalescing window has closed are reported now
+    if (!titleCoalescer_.takeDue().empty()) {
+        changed = true;
+    }
+
+    std::lock_guard<std::mutex> lock(pendingChangesMutex_);
+    for (const auto& [window, properties] : changes.windows) {
+        pendingChanges_.windows[window] |= properties;
+    }
+    pendingChanges_.root |= changes.root;
+    pendingChanges_.structure = pendingChanges_.structure || changes.structure;
+    eventsDrained_ = true;
+    notificationsConsumed_ = true;
+
+    return changed;
+}
+
+bool X11Enumerator::waitForChanges(std::chrono::milliseconds timeout) {
+    if (!ensureChangeNotifications()) {
+        return WindowEnumerator::waitForChanges(timeout);
+    }
+
+    applyPendingWatches();
+
+    // Events may already be queued client-side, in which case poll() would not wake
+    if (drainChangeEvents()) {
+        return true;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+
+        // Wake early for held title changes
+        auto wake = deadline;
+        auto held = titleCoalescer_.nextDeadline();
+        if (held && *held < wake) {
+            wake = *held;
+        }
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(wake - now);
+
+        pollfd descriptors[2] = {};
+        descriptors[0].fd = ConnectionNumber(eventDisplay_);
+        descriptors[0].events = POLLIN;
+        descriptors[1].fd = wakeFd_; // Ignored by poll() while negative
+        descriptors[1].events = POLLIN;
+
+        int ready = poll(descriptors, 2, static_cast<int>(wait.count()));
+        if (ready < 0 && errno != EINTR) {
+            return false;
+        }
+
+        if (ready > 0 && (descriptors[1].revents & POLLIN)) {
+            uint64_t count;
+            while (read(wakeFd_, &count, sizeof(count)) > 0) {
+            }
+            return drainChangeEvents();
+        }
+
+        // Irrelevant traffic (e.g. _NET_WM_USER_TIME updates) keeps waiting
+        if ((ready > 0 || held) && drainChangeEvents()) {
+            return true;
+        }
+    }
+}
+
+void X11Enumerator::interruptWaitForChanges() {
+    if (wakeFd_ < 0 || eventsFailed_) {
+        WindowEnumerator::interruptWaitForChanges(); // waitForChanges() is polling
+        return;
+    }
+    uint64_t one = 1;
+    if (write(wakeFd_, &one, sizeof(one)) < 0) {
+        // Counter saturated: a wake-up is already pending
+    }
+}
+
+int X11Enumerator::getChangeNotificationFd() const {
+    return ensureChangeNotifications() ? ConnectionNumber(eventDisplay_) : -1;
+}
+
+bool X11Enumerator::processChangeNotifications() {
+    if (!ensureChangeNotifications()) {
+        return false;
+    }
+
+    applyPendingWatches();
+    return drainChangeEvents();
+}
+
+void X11Enumerator::setChangeCoalescingLatency(std::chrono::milliseconds latency) {
+    titleCoalescer_.setLatency(latency);
+}
+
+std::optional<std::chrono::steady_clock::time_point> X11Enumerator::getNextChangeDeadline() const {
+    return titleCoalescer_.nextDeadline();
+}
+
+ChangeCoalescingStats X11Enumerator::getChangeCoalescingStats() const {
+    return titleCoalescer_.getStats();
+}
+
+// Window previews
+
+bool X11Enumerator::initializeCapture() {
+    if (captureDisplay_) {
+        return true;
+    }
+
+    captureDisplay_ = XOpenDisplay(DisplayString(display_));
+    if (!captureDisplay_) {
+        return false;
+    }
+    installErrorHandler();
+
+#ifdef HAVE_XCOMPOSITE
+    // NameWindowPixmap needs Composite 0.2; it keeps working for obscured windows
+    int eventBase = 0, errorBase = 0, major = 0, minor = 2;
+    compositeAvailable_ = XCompositeQueryExtension(captureDisplay_, &eventBase, &errorBase) &&
+                          XCompositeQueryVersion(captureDisplay_, &major, &minor) &&
+                          (major > 0 || minor >= 2);
+#endif
+#ifdef HAVE_XSHM
+    shmAvailable_ = XShmQueryExtension(captureDisplay_);
+#endif
+
+    return true;
+}
+
+void X11Enumerator::cleanupCapture() {
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    if (!captureDisplay_) {
+        return;
+    }
+#ifdef HAVE_XSHM
+    releaseCaptureSegment();
+#endif
+    XCloseDisplay(captureDisplay_);
+    captureDisplay_ = nullptr;
+}
+
+#ifdef HAVE_XSHM
+bool X11Enumerator::ensureCaptureSegment(size_t size) {
+    if (captureShmSize_ >= size) {
+        return true;
+    }
+    releaseCaptureSegment();
+
+    int shmId = shmget(IPC_PRIVATE, size, IPC_CREAT | 0600);
+    if (shmId < 0) {
+        return false;
+    }
+
+    void* address = shmat(shmId, nullptr, 0);
+    if (address == reinterpret_cast<void*>(-1)) {
+        shmctl(shmId, IPC_RMID, nullptr);
+        return false;
+    }
+
+    captureShm_.shmid = shmId;
+    captureShm_.shmaddr = static_cast<char*>(address);
+    captureShm_.readOnly = False;
+
+    resetErrorTrap(captureDisplay_);
+    bool attached = XShmAttach(captureDisplay_, &captureShm_);
+    XSync(captureDisplay_, False);
+
+    // Marked for removal now; the kernel frees it once both sides have detached
+    shmctl(shmId, IPC_RMID, nullptr);
+
+    if (!attached || errorTrapped(captureDisplay_)) {
+        // Typically a remote display - stay on the XGetImage path from now on
+        shmdt(captureShm_.shmaddr);
+        captureShm_ = XShmSegmentInfo{};
+        shmAvailable_ = false;
+        return false;
+    }
+
+    captureShmSize_ = size;
+    return true;
+}
+
+void X11Enumerator::releaseCaptureSegment() {
+    if (captureShmSize_ == 0) {
+        return;
+    }
+    XShmDetach(captureDisplay_, &captureShm_);
+    XSync(captureDisplay_, False);
+    shmdt(captureShm_.shmaddr);
+    captureShm_ = XShmSegmentInfo{};
+    captureShmSize_ = 0;
+}
+#endif
+
+XImage* X11Enumerator::grabImage(Drawable source, const XWindowAttributes& attrs) {
+#ifdef HAVE_XSHM
+    if (shmAvailable_) {
+        // Zero-copy: the server writes straight into the shared segment
+        XImage* image = XShmCreateImage(captureDisplay_, attrs.visual, attrs.depth, ZPixmap,
+                                        nullptr, &captureShm_, attrs.width, attrs.height);
+        if (image) {
+            size_t required = static_cast<size_t>(image->bytes_per_line) * image->height;
+            if (ensureCaptureSegment(required)) {
+                image->data = captureShm_.shmaddr;
+                resetErrorTrap(captureDisplay_);
+                if (XShmGetImage(captureDisplay_, source, image, 0, 0, AllPlanes) && !errorTrapped(captureDisplay_)) {
+                    return image;
+                }
+            }
+            image->data = nullptr; // Owned by the segment, not by the image
+            XDestroyImage(image);
+        }
+    }
+#endif
+
+    resetErrorTrap(captureDisplay_);
+    XImage* image = XGetImage(captureDisplay_, source, 0, 0, attrs.width, attrs.height, AllPlanes, ZPixmap);
+    if (image && errorTrapped(captureDisplay_)) {
+        XDestroyImage(image);
+        return nullptr;
+    }
+    return image;
+}
+
+void X11Enumerator::releaseImage(XImage* image) {
+#ifdef HAVE_XSHM
+    if (captureShmSize_ > 0 && image->data == captureShm_.shmaddr) {
+        image->data = nullptr;
+    }
+#endif
+    XDestroyImage(image);
+}
+
+std::optional<WindowThumbnail> X11Enumerator::captureThumbnail(const std::string& handle,
+                                                               unsigned int maxWidth, unsigned int maxHeight) {
+    Window window = stringToHandle(handle);
+    if (window == 0 || maxWidth == 0 || maxHeight == 0) {
+        return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(captureMutex_);
+    if (!initializeCapture()) {
+        return std::nullopt;
+    }
+
+    resetErrorTrap(captureDisplay_);
+
+    XWindowAttributes attrs;
+    if (!XGetWindowAttributes(captureDisplay_, window, &attrs) || errorTrapped(captureDisplay_) ||
+        attrs.map_state != IsViewable || attrs.width <= 0 || attrs.height <= 0) {
+        releaseErrorTrap(captureDisplay_);
+        return std::nullopt;
+    }
+
+    Drawable source = window;
+#ifdef HAVE_XCOMPOSITE
+    Pixmap pixmap = 0;
+    if (compositeAvailable_) {
+        // Off-screen copy of the window, valid even when it is covered by other windows
+        XCompositeRedirectWindow(captureDisplay_, window, CompositeRedirectAutomatic);
+        pixmap = XCompositeNameWindowPixmap(captureDisplay_, window);
+        XSync(captureDisplay_, False);
+        if (errorTrapped(captureDisplay_)) {
+            pixmap = 0; // Fall back to reading the window itself
+        } else {
+            source = pixmap;
+        }
+    }
+#endif
+
+    std::optional<WindowThumbnail> thumbnail;
+    XImage* image = grabImage(source, attrs);
+    if (image) {
+        // Nearest-neighbour downsample preserving the aspect ratio
+        double scale = std::min({1.0,
+                                 static_cast<double>(maxWidth) / attrs.width,
+                                 static_cast<double>(maxHeight) / attrs.height});
+        WindowThumbnail result;
+        result.handle = handle;
+        result.width = std::max(1u, static_cast<unsigned int>(attrs.width * scale));
+        result.height = std::max(1u, static_cast<unsigned int>(attrs.height * scale));
+        result.pixels.reserve(static_cast<size_t>(result.width) * result.height);
+
+        for (unsigned int y = 0; y < result.height; ++y) {
+            int sourceY = static_cast<int>((y + 0.5) * attrs.height / result.height);
+            for (unsigned int x = 0; x < result.width; ++x) {
+                int sourceX = static_cast<int>((x + 0.5) * attrs.width / result.width);
+                unsigned long pixel = XGetPixel(image, sourceX, sourceY);
+                result.pixels.push_back((extractChannel(pixel, image->red_mask) << 16) |
+                                        (extractChannel(pixel, image->green_mask) << 8) |
+                                        extractChannel(pixel, image->blue_mask));
+            }
+        }
+        result.capturedAt = std::chrono::steady_clock::now();
+        thumbnail = std::move(result);
+
+        releaseImage(image);
+    }
+
+#ifdef HAVE_XCOMPOSITE
+    if (pixmap) {
+        XFreePixmap(captureDisplay_, pixmap);
+    }
+    if (compositeAvailable_) {
+        XCompositeUnredirectWindow(captureDisplay_, window, CompositeRedirectAutomatic);
+    }
+#endif
+    XSync(captureDisplay_, False);
+    releaseErrorTrap(captureDisplay_);
+
+    return thumbnail;
+}
+
 } // namespace WindowManager
 
-#endif // WM_PLATFORM_LINUX
\ No newline at end of file
+#endif // WM_PLATFORM_LINUX
@@ -5,6 +5,16 @@
 
 #ifdef WM_PLATFORM_LINUX
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef HAVE_XSHM
+#include <X11/extensions/XShm.h>
+#endif
+
 namespace WindowManager {
 
 /**
@@ -12,7 +22,7 @@ namespace WindowManager {
  */
 class X11Enumerator : public WindowEnumerator {
 public:
-    X11Enumerator();
+    explicit X11Enumerator(const std::string& displayName = ""); // Empty = $DISPLAY
     ~X11Enumerator() override;
 
     // WindowEnumerator interface implementation
@@ -35,16 +45,76 @@ public:
     bool switchToWorkspace(const std::string& workspaceId) override;
     bool canSwitchWorkspaces() const override;
 
+    // Change notifications (PropertyNotify / structure events on a dedicated connection,
+    // opened on the first getChangeNotificationFd()/waitForChanges()/processChangeNotifications()
+    // so one-shot callers never pay for it). Supported until opening it has failed.
+    bool supportsChangeNotifications() const override;
+    bool waitForChanges(std::chrono::milliseconds timeout) override;
+    void interruptWaitForChanges() override;
+    int getChangeNotificationFd() const override;
+    bool processChangeNotifications() override;
+    void setChangeCoalescingLatency(std::chrono::milliseconds latency) override;
+    std::optional<std::chrono::steady_clock::time_point> getNextChangeDeadline() const override;
+    ChangeCoalescingStats getChangeCoalescingStats() const override;
+
+    // Window previews (XComposite named pixmap + MIT-SHM when available)
+    std::optional<WindowThumbnail> captureThumbnail(const std::string& handle,
+                                                    unsigned int maxWidth, unsigned int maxHeight) override;
+
     // Performance and diagnostics
     std::chrono::milliseconds getLastEnumerationTime() const override;
     size_t getWindowCount() const override;
     std::string getPlatformInfo() const override;
+    uint64_t getServerRequestCount() const override;
 
 private:
     // X11 display connection
+    std::string displayName_;
     Display* display_;
     Window rootWindow_;
 
+    // Property groups tracked per window. Set from PropertyNotify / ConfigureNotify /
+    // Map events while draining notifications; the next enumeration re-fetches only these.
+    enum DirtyProperty : uint32_t {
+        DirtyName       = 1u << 0,
+        DirtyGeometry   = 1u << 1,
+        DirtyVisibility = 1u << 2,
+        DirtyState      = 1u << 3, // _NET_WM_STATE
+        DirtyDesktop    = 1u << 4, // _NET_WM_DESKTOP
+        DirtyPid        = 1u << 5,
+        DirtyAll        = (1u << 6) - 1
+    };
+
+    // Root window properties every window's derived state depends on
+    enum RootProperty : uint32_t {
+        RootActiveWindow   = 1u << 0,
+        RootCurrentDesktop = 1u << 1,
+        RootDesktopNames   = 1u << 2,
+        RootAll            = (1u << 3) - 1
+    };
+
+    // Raw per-window properties; WindowInfo's workspace and state fields are derived
+    // from these plus the root properties without further round trips
+    struct CachedWindow {
+        WindowInfo info;
+        Window topLevel = 0;       // Child of the root containing the window (its frame)
+        unsigned long desktop = 0; // _NET_WM_DESKTOP
+        bool hidden = false;       // _NET_WM_STATE_HIDDEN
+    };
+
+    struct PendingChanges {
+        std::unordered_map<Window, uint32_t> windows; // Client or frame -> DirtyProperty mask
+        uint32_t root = 0;                            // RootProperty mask
+        bool structure = false;                       // Windows created, destroyed or reparented
+    };
+
+    // Missed events are repaired by a full pass at least this often
+    static constexpr std::chrono::milliseconds FULL_RECONCILE_INTERVAL{30000};
+    // Longest focusWindow() waits for the window manager to show the target desktop
+    static constexpr std::chrono::milliseconds DESKTOP_SWITCH_TIMEOUT{200};
+    // Re-check interval while nobody drains the event connection
+    static constexpr std::chrono::milliseconds DESKTOP_SWITCH_POLL{10};
+
     // Helper methods for X11 API
     void initializeX11();
     void cleanupX11();
@@ -54,7 +124,7 @@ private:
     void getWindowGeometry(Window window, int& x, int& y, unsigned int& width, unsigned int& height);
     unsigned long getWindowPid(Window window);
     bool isWindowVisible(Window window);
-    void enumerateWindowsRecursive(Window window, std::vector<WindowInfo>& windows);
+    bool isWindowHidden(Window window);
     Window stringToHandle(const std::string& handleStr);
     std::string handleToString(Window window);
 
@@ -71,18 +141,105 @@ private:
     Atom netCurrentDesktopAtom_;
     Atom netWmDesktopAtom_;
     Atom netActiveWindowAtom_;
+    Atom netClientListAtom_;
 
     void initializeEWMH();
     std::string getProperty(Window window, Atom property);
     unsigned long getPropertyLong(Window window, Atom property);
 
     // NEW: Workspace helper methods
-    std::string getWindowWorkspaceId(Window window);
-    std::string getWorkspaceName(const std::string& workspaceId);
-    bool isWindowOnCurrentWorkspace(Window window);
-    WindowState getWindowState(Window window);
+    std::string getWorkspaceName(const std::string& workspaceId) const; // From the cached desktop names
     int getCurrentDesktopIndex();
     int getWindowDesktopIndex(Window window);
+    // True once _NET_CURRENT_DESKTOP reads `desktop`, false after `timeout`
+    bool waitForCurrentDesktop(int desktop, std::chrono::milliseconds timeout);
+
+    // Window cache, owned by the enumerating thread
+    std::unordered_map<Window, CachedWindow> windowCache_;
+    std::vector<Window> windowOrder_; // Tree order of the last walk
+    // Windows the last walk rejected -> properties whose change may admit them (a title
+    // set after mapping, a late _NET_WM_PID, a resize away from 0x0). Watched like clients.
+    std::unordered_map<Window, uint32_t> candidates_;
+    std::chrono::steady_clock::time_point lastFullEnumeration_;
+    bool hasFullEnumeration_; // A full walk ran with the event connection open (every window watched)
+    Window activeWindow_;
+    int currentDesktop_;
+    std::vector<std::string> desktopNames_;
+
+    bool canEnumerateIncrementally(std::chrono::steady_clock::time_point now);
+    void enumerateFully();
+    void enumerateIncrementally();
+    void walkWindowTree(Window window, Window topLevel, bool reuseCached,
+                        std::unordered_map<Window, CachedWindow>& cache, std::vector<Window>& order,
+                        std::unordered_map<Window, uint32_t>& candidates);
+    // False for windows not listed; `retryOn` then names the properties that were missing
+    bool admitWindow(Window window, CachedWindow& entry, uint32_t& retryOn);
+    bool stillAdmitted(const CachedWindow& entry, uint32_t& retryOn) const; // Re-check of a cached window
+    void fetchWindowProperties(Window window, CachedWindow& entry, uint32_t properties);
+    void refreshRootProperties(uint32_t properties);
+    void deriveWindowInfo(Window window, CachedWindow& entry) const;
+    std::vector<WindowInfo> collectCachedWindows();
+
+    // Change notification state. eventDisplay_ is opened by the first consumer (hence
+    // mutable: getChangeNotificationFd() is const) and only touched by the thread draining
+    // it; enumeration queues new windows to watch once eventsOpen_ is set.
+    mutable std::once_flag eventDisplayOnce_;
+    mutable Display* eventDisplay_;
+    mutable std::atomic<bool> eventsOpen_;
+    mutable std::atomic<bool> eventsFailed_;
+    int wakeFd_; // eventfd ending waitForChanges() early
+    std::mutex watchMutex_;
+    std::vector<Window> pendingWatches_;
+    std::unordered_set<Window> watchedWindows_;
+
+    // Filled by the notification thread, consumed by the next enumeration. Incremental
+    // enumeration is only trusted while someone drains notifications (eventsDrained_).
+    std::mutex pendingChangesMutex_;
+    PendingChanges pendingChanges_;
+    bool eventsDrained_;
+    ChangeCoalescer titleCoalescer_; // Per-window title bursts (_NET_WM_NAME / WM_NAME)
+
+    // Workspace table served by enumerateWorkspaces()/getCurrentWorkspace(). Root
+    // PropertyNotify on the _NET_*DESKTOP* atoms bumps workspaceEpoch_; the table is
+    // reused while its epoch is current, as long as notifications are being drained.
+    mutable std::mutex workspaceMutex_;
+    std::vector<WorkspaceInfo> workspaceTable_;
+    uint64_t workspaceTableEpoch_;
+    std::chrono::steady_clock::time_point workspaceTableBuilt_;
+    std::atomic<uint64_t> workspaceEpoch_;
+    std::condition_variable workspaceChanged_; // Notified with workspaceEpoch_, under workspaceMutex_
+    std::atomic<bool> notificationsConsumed_;
+
+    bool isWorkspaceChange(const XEvent& event) const;
+    std::vector<WorkspaceInfo> buildWorkspaceTable();
+
+    void initializeChangeNotifications() const;
+    bool ensureChangeNotifications() const; // Opens the event connection on first use
+    void cleanupChangeNotifications();
+    void queueWindowWatch(Window window);
+    void applyPendingWatches();
+    bool drainChangeEvents();
+    bool isRelevantChange(const XEvent& event) const;
+    void recordChange(const XEvent& event, PendingChanges& changes) const;
+    PendingChanges takePendingChanges();
+
+    // Capture state, guarded by captureMutex_. Captures use their own connection so a
+    // slow XShmGetImage never holds up enumeration or change notifications.
+    std::mutex captureMutex_;
+    Display* captureDisplay_;
+    bool compositeAvailable_;
+    bool shmAvailable_;
+#ifdef HAVE_XSHM
+    XShmSegmentInfo captureShm_;   // Reused across captures; grown on demand
+    size_t captureShmSize_;
+    bool ensureCaptureSegment(size_t size);
+    void releaseCaptureSegment();
+#endif
+
+    bool initializeCapture();
+    void cleanupCapture();
+    XImage* grabImage(Drawable source, const XWindowAttributes& attrs);
+    void releaseImage(XImage* image);
 };
 
 } // namespace WindowManager
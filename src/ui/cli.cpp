@@ -14,10 +14,18 @@ void CLI::setOutputFormat(const std::string& format) {
     }
 }
 
+void CLI::setHighlightMatches(bool highlight) {
+    highlightMatches_ = highlight;
+}
+
 void CLI::setVerbose(bool verbose) {
     verbose_ = verbose;
 }
 
+void CLI::setEtag(const std::string& etag) {
+    etag_ = etag;
+}
+
 void CLI::displayAllWindows(const std::vector<WindowInfo>& windows) {
     if (outputFormat_ == "json") {
         displayWindowsAsJson(windows);
@@ -73,8 +81,11 @@ void CLI::displayWindowsHandlesOnly(const std::vector<WindowInfo>& windows) {
         }
 
         std::cout << "  ],\n";
-        std::cout << "  \"totalCount\": " << windows.size() << "\n";
-        std::cout << "}" << std::endl;
+        std::cout << "  \"totalCount\": " << windows.size();
+        if (!etag_.empty()) {
+            std::cout << ",\n  \"etag\": \"" << escapeJsonString(etag_) << "\"";
+        }
+        std::cout << "\n}" << std::endl;
     } else {
         std::cout << "Window Handles (" << windows.size() << " total):" << std::endl;
         std::cout << std::endl;
@@ -148,7 +159,7 @@ void CLI::displayFilteredResults(const FilterResult& result) {
 
         if (result.filteredCount > 0) {
             std::cout << std::endl;
-            displayWindowsAsText(result.windows);
+            displayWindowsAsText(result.windows, highlightMatches_ ? &result.query : nullptr);
         }
 
         // Show performance warning if needed
@@ -175,6 +186,9 @@ void CLI::displayNoMatches(const std::string& keyword) {
         std::cout << "    \"totalCount\": 0,\n";
         std::cout << "    \"filteredCount\": 0,\n";
         std::cout << "    \"query\": \"" << escapeJsonString(keyword) << "\",\n";
+        if (!etag_.empty()) {
+            std::cout << "    \"etag\": \"" << escapeJsonString(etag_) << "\",\n";
+        }
         std::cout << "    \"message\": \"No windows found matching the search criteria\"\n";
         std::cout << "  }\n";
         std::cout << "}" << std::endl;
@@ -187,6 +201,14 @@ void CLI::displayNoMatches(const std::string& keyword) {
     }
 }
 
+void CLI::displayNotModified(const std::string& etag) {
+    if (outputFormat_ == "json") {
+        std::cout << "{\"notModified\": true, \"etag\": \"" << escapeJsonString(etag) << "\"}" << std::endl;
+    } else {
+        std::cout << "Not modified (ETag: " << etag << ")" << std::endl;
+    }
+}
+
 void CLI::displayPerformanceStats(std::chrono::milliseconds duration, size_t windowCount) {
     if (verbose_) {
         if (outputFormat_ == "json") {
@@ -220,7 +242,7 @@ bool CLI::promptYesNo(const std::string& question) {
 }
 
 // Text output implementation
-void CLI::displayWindowsAsText(const std::vector<WindowInfo>& windows) {
+void CLI::displayWindowsAsText(const std::vector<WindowInfo>& windows, const SearchQuery* highlightQuery) {
     if (windows.empty()) {
         std::cout << "No windows found." << std::endl;
         return;
@@ -229,7 +251,7 @@ void CLI::displayWindowsAsText(const std::vector<WindowInfo>& windows) {
     std::cout << "Windows (" << windows.size() << " total):" << std::endl;
 
     for (size_t i = 0; i < windows.size(); ++i) {
-        displayWindowAsText(windows[i], static_cast<int>(i + 1));
+        displayWindowAsText(windows[i], static_cast<int>(i + 1), highlightQuery);
 
         // Add separator between windows (except for the last one)
         if (i < windows.size() - 1) {
@@ -238,16 +260,24 @@ void CLI::displayWindowsAsText(const std::vector<WindowInfo>& windows) {
     }
 }
 
-void CLI::displayWindowAsText(const WindowInfo& window, int index) {
+void CLI::displayWindowAsText(const WindowInfo& window, int index, const SearchQuery* highlightQuery) {
     std::ostringstream oss;
 
     if (index > 0) {
         oss << "[" << index << "] ";
     }
 
-    oss << window.ownerName;
-    if (!window.title.empty()) {
-        oss << " - " << truncateString(window.title, DEFAULT_TITLE_TRUNCATE_LENGTH);
+    std::string title = truncateString(window.title, DEFAULT_TITLE_TRUNCATE_LENGTH);
+    if (highlightQuery) {
+        oss << highlightMatches(window.ownerName, SearchField::Owner, *highlightQuery);
+        if (!title.empty()) {
+            oss << " - " << highlightMatches(title, SearchField::Title, *highlightQuery);
+        }
+    } else {
+        oss << window.ownerName;
+        if (!title.empty()) {
+            oss << " - " << title;
+        }
     }
 
     std::cout << oss.str() << std::endl;
@@ -315,6 +345,9 @@ void CLI::displayWindowsAsJson(const std::vector<WindowInfo>& windows) {
 
     std::cout << "  ],\n";
     std::cout << "  \"totalCount\": " << windows.size() << ",\n";
+    if (!etag_.empty()) {
+        std::cout << "  \"etag\": \"" << escapeJsonString(etag_) << "\",\n";
+    }
 
     // Add timestamp
     auto now = std::chrono::system_clock::now();
@@ -370,6 +403,24 @@ std::string CLI::formatPosition(int x, int y) {
     return "(" + std::to_string(x) + ", " + std::to_string(y) + ")";
 }
 
+std::string CLI::highlightMatches(const std::string& text, SearchField textField, const SearchQuery& query) const {
+    // Only printed rows are scanned for match positions
+    auto spans = query.findMatchSpans(text, textField);
+    if (spans.empty()) {
+        return text;
+    }
+
+    std::string highlighted;
+    size_t position = 0;
+    for (const auto& span : spans) {
+        highlighted += text.substr(position, span.offset - position);
+        highlighted += "\033[1;33m" + text.substr(span.offset, span.length) + "\033[0m";
+        position = span.offset + span.length;
+    }
+    highlighted += text.substr(position);
+    return highlighted;
+}
+
 std::string CLI::truncateString(const std::string& str, size_t maxLength) {
     if (str.length() <= maxLength) {
         return str;
@@ -891,68 +942,42 @@ SearchQuery CLI::parseSearchQuery(const std::string& query, const std::vector<st
 
 // T040-T041: Cross-workspace management functionality implementation
 
-void CLI::displayWorkspaceSummary(const std::vector<WorkspaceInfo>& workspaces, const std::vector<WindowInfo>& allWindows) {
+void CLI::displayWorkspaceSummary(const std::vector<WorkspaceInfo>& workspaces, const WindowSnapshot& snapshot) {
+    auto counts = countWindowsPerWorkspace(workspaces, snapshot.workspaceBuckets.get(), snapshot.workspaceStateCounts);
+
     if (outputFormat_ == "json") {
         std::cout << "{\n";
         std::cout << "  \"workspaces\": [\n";
 
-        bool firstWorkspace = true;
-        for (const auto& workspace : workspaces) {
-            if (!firstWorkspace) {
+        for (size_t i = 0; i < workspaces.size(); ++i) {
+            const auto& workspace = workspaces[i];
+            if (i > 0) {
                 std::cout << ",\n";
             }
-            firstWorkspace = false;
-
-            // Count windows in this workspace
-            size_t windowCount = 0;
-            size_t visibleCount = 0;
-            size_t minimizedCount = 0;
-            size_t focusedCount = 0;
-
-            for (const auto& window : allWindows) {
-                if (window.workspaceId == workspace.id) {
-                    windowCount++;
-                    if (window.isVisible) visibleCount++;
-                    if (window.isMinimized) minimizedCount++;
-                    if (window.isFocused) focusedCount++;
-                }
-            }
 
             std::cout << "    {\n";
             std::cout << "      \"id\": \"" << escapeJsonString(workspace.id) << "\",\n";
             std::cout << "      \"name\": \"" << escapeJsonString(workspace.name) << "\",\n";
             std::cout << "      \"index\": " << workspace.index << ",\n";
             std::cout << "      \"isCurrent\": " << (workspace.isCurrent ? "true" : "false") << ",\n";
-            std::cout << "      \"windowCount\": " << windowCount << ",\n";
-            std::cout << "      \"visibleCount\": " << visibleCount << ",\n";
-            std::cout << "      \"minimizedCount\": " << minimizedCount << ",\n";
-            std::cout << "      \"focusedCount\": " << focusedCount << "\n";
+            std::cout << "      \"windowCount\": " << counts[i].windows << ",\n";
+            std::cout << "      \"visibleCount\": " << counts[i].visible << ",\n";
+            std::cout << "      \"minimizedCount\": " << counts[i].minimized << ",\n";
+            std::cout << "      \"focusedCount\": " << counts[i].focused << "\n";
             std::cout << "    }";
         }
 
         std::cout << "\n  ],\n";
         std::cout << "  \"totalWorkspaces\": " << workspaces.size() << ",\n";
-        std::cout << "  \"totalWindows\": " << allWindows.size() << "\n";
+        std::cout << "  \"totalWindows\": " << snapshot.windows.size() << "\n";
         std::cout << "}" << std::endl;
     } else {
         std::cout << "Workspace Summary:" << std::endl;
         std::cout << "==================" << std::endl;
 
-        for (const auto& workspace : workspaces) {
-            // Count windows in this workspace
-            size_t windowCount = 0;
-            size_t visibleCount = 0;
-            size_t minimizedCount = 0;
-            size_t focusedCount = 0;
-
-            for (const auto& window : allWindows) {
-                if (window.workspaceId == workspace.id) {
-                    windowCount++;
-                    if (window.isVisible) visibleCount++;
-                    if (window.isMinimized) minimizedCount++;
-                    if (window.isFocused) focusedCount++;
-                }
-            }
+        for (size_t i = 0; i < workspaces.size(); ++i) {
+            const auto& workspace = workspaces[i];
+            const auto& count = counts[i];
 
             std::cout << workspace.name << " (ID: " << workspace.id << ")";
             if (workspace.isCurrent) {
@@ -960,14 +985,14 @@ void CLI::displayWorkspaceSummary(const std::vector<WorkspaceInfo>& workspaces,
             }
             std::cout << std::endl;
 
-            std::cout << "  Windows: " << windowCount;
-            if (windowCount > 0) {
-                std::cout << " (Visible: " << visibleCount;
-                if (minimizedCount > 0) {
-                    std::cout << ", Minimized: " << minimizedCount;
+            std::cout << "  Windows: " << count.windows;
+            if (count.windows > 0) {
+                std::cout << " (Visible: " << count.visible;
+                if (count.minimized > 0) {
+                    std::cout << ", Minimized: " << count.minimized;
                 }
-                if (focusedCount > 0) {
-                    std::cout << ", Focused: " << focusedCount;
+                if (count.focused > 0) {
+                    std::cout << ", Focused: " << count.focused;
                 }
                 std::cout << ")";
             }
@@ -975,7 +1000,7 @@ void CLI::displayWorkspaceSummary(const std::vector<WorkspaceInfo>& workspaces,
             std::cout << std::endl;
         }
 
-        std::cout << "Total: " << workspaces.size() << " workspaces, " << allWindows.size() << " windows" << std::endl;
+        std::cout << "Total: " << workspaces.size() << " workspaces, " << snapshot.windows.size() << " windows" << std::endl;
     }
 }
 
@@ -1163,40 +1188,28 @@ void CLI::displayFocusedWindowInfo(const std::optional<WindowInfo>& focusedWindo
     }
 }
 
-void CLI::displayCrossWorkspaceStatistics(const std::vector<WindowInfo>& allWindows, const std::vector<WorkspaceInfo>& workspaces) {
+void CLI::displayCrossWorkspaceStatistics(const WindowSnapshot& snapshot, const std::vector<WorkspaceInfo>& workspaces) {
+    // Tallied when the snapshot was built
+    size_t visibleWindows = snapshot.stateCounts.visible;
+    size_t minimizedWindows = snapshot.stateCounts.minimized;
+    size_t focusedWindows = snapshot.stateCounts.focused;
+    auto counts = countWindowsPerWorkspace(workspaces, snapshot.workspaceBuckets.get(), snapshot.workspaceStateCounts);
+
     if (outputFormat_ == "json") {
         std::cout << "{\n";
         std::cout << "  \"statistics\": {\n";
-        std::cout << "    \"totalWindows\": " << allWindows.size() << ",\n";
+        std::cout << "    \"totalWindows\": " << snapshot.windows.size() << ",\n";
         std::cout << "    \"totalWorkspaces\": " << workspaces.size() << ",\n";
-
-        // Calculate statistics
-        size_t visibleWindows = 0;
-        size_t minimizedWindows = 0;
-        size_t focusedWindows = 0;
-        std::map<std::string, size_t> windowsByWorkspace;
-
-        for (const auto& window : allWindows) {
-            if (window.isVisible) visibleWindows++;
-            if (window.isMinimized) minimizedWindows++;
-            if (window.isFocused) focusedWindows++;
-            windowsByWorkspace[window.workspaceId]++;
-        }
-
         std::cout << "    \"visibleWindows\": " << visibleWindows << ",\n";
         std::cout << "    \"minimizedWindows\": " << minimizedWindows << ",\n";
         std::cout << "    \"focusedWindows\": " << focusedWindows << ",\n";
         std::cout << "    \"windowsByWorkspace\": {\n";
 
-        bool firstWorkspace = true;
-        for (const auto& workspace : workspaces) {
-            if (!firstWorkspace) {
+        for (size_t i = 0; i < workspaces.size(); ++i) {
+            if (i > 0) {
                 std::cout << ",\n";
             }
-            firstWorkspace = false;
-
-            size_t count = windowsByWorkspace[workspace.id];
-            std::cout << "      \"" << escapeJsonString(workspace.id) << "\": " << count;
+            std::cout << "      \"" << escapeJsonString(workspaces[i].id) << "\": " << counts[i].windows;
         }
 
         std::cout << "\n    }\n";
@@ -1206,20 +1219,7 @@ void CLI::displayCrossWorkspaceStatistics(const std::vector<WindowInfo>& allWind
         std::cout << "Cross-Workspace Statistics:" << std::endl;
         std::cout << "===========================" << std::endl;
 
-        // Calculate statistics
-        size_t visibleWindows = 0;
-        size_t minimizedWindows = 0;
-        size_t focusedWindows = 0;
-        std::map<std::string, size_t> windowsByWorkspace;
-
-        for (const auto& window : allWindows) {
-            if (window.isVisible) visibleWindows++;
-            if (window.isMinimized) minimizedWindows++;
-            if (window.isFocused) focusedWindows++;
-            windowsByWorkspace[window.workspaceId]++;
-        }
-
-        std::cout << "Total Windows: " << allWindows.size() << std::endl;
+        std::cout << "Total Windows: " << snapshot.windows.size() << std::endl;
         std::cout << "Total Workspaces: " << workspaces.size() << std::endl;
         std::cout << "Visible Windows: " << visibleWindows << std::endl;
         std::cout << "Minimized Windows: " << minimizedWindows << std::endl;
@@ -1227,11 +1227,30 @@ void CLI::displayCrossWorkspaceStatistics(const std::vector<WindowInfo>& allWind
         std::cout << std::endl;
 
         std::cout << "Windows per Workspace:" << std::endl;
-        for (const auto& workspace : workspaces) {
-            size_t count = windowsByWorkspace[workspace.id];
-            std::cout << "  " << formatWorkspaceInfo(workspace, false) << ": " << count << " windows" << std::endl;
+        for (size_t i = 0; i < workspaces.size(); ++i) {
+            std::cout << "  " << formatWorkspaceInfo(workspaces[i], false) << ": " << counts[i].windows << " windows" << std::endl;
+        }
+    }
+}
+
+std::vector<CLI::WorkspaceWindowCounts> CLI::countWindowsPerWorkspace(
+    const std::vector<WorkspaceInfo>& workspaces, const WorkspaceBuckets* buckets,
+    const std::map<std::string, WindowStateCounts>& stateCounts) const {
+    std::vector<WorkspaceWindowCounts> counts(workspaces.size());
+    for (size_t i = 0; i < workspaces.size(); ++i) {
+        auto& count = counts[i];
+        auto it = stateCounts.find(workspaces[i].id);
+        if (it != stateCounts.end()) {
+            count.visible = it->second.visible;
+            count.minimized = it->second.minimized;
+            count.focused = it->second.focused;
+            count.windows = it->second.visible + it->second.hidden;
+        }
+        if (buckets) {
+            count.windows = buckets->countOn(workspaces[i].id);
         }
     }
+    return counts;
 }
 
 std::string CLI::formatWorkspaceInfo(const WorkspaceInfo& workspace, bool includeIndex) {
@@ -3,6 +3,7 @@
 #include "../core/window.hpp"
 #include "../core/workspace.hpp"
 #include "../core/focus_operation.hpp"
+#include "../core/window_snapshot.hpp"
 #include "../filters/search_query.hpp"
 #include <vector>
 #include <string>
@@ -33,6 +34,8 @@ public:
     // Output format configuration
     void setOutputFormat(const std::string& format);
     void setVerbose(bool verbose);
+    void setHighlightMatches(bool highlight); // ANSI match highlighting in text search output
+    void setEtag(const std::string& etag);     // Included in JSON list and no-match output
 
     // Display methods for User Story 1
     void displayAllWindows(const std::vector<WindowInfo>& windows);
@@ -49,6 +52,7 @@ public:
     // Display methods for User Story 2 (Enhanced Search Functionality)
     void displayFilteredResults(const FilterResult& result);
     void displayNoMatches(const std::string& keyword);
+    void displayNotModified(const std::string& etag); // Reply to --if-changed with a current etag
 
     // T037-T039: Enhanced search functionality
     void displayEnhancedSearchResults(const FilterResult& result);
@@ -63,14 +67,14 @@ public:
     void displayTroubleshootingHelp();
 
     // T040-T041: Cross-workspace management functionality
-    void displayWorkspaceSummary(const std::vector<WorkspaceInfo>& workspaces, const std::vector<WindowInfo>& allWindows);
+    void displayWorkspaceSummary(const std::vector<WorkspaceInfo>& workspaces, const WindowSnapshot& snapshot);
     void displayWorkspaceStatus(const std::vector<WorkspaceInfo>& workspaces);
     void displayFilteredByWorkspace(const std::vector<WindowInfo>& windows, const std::string& workspaceId, const std::vector<WorkspaceInfo>& workspaces);
     void displayCurrentWorkspaceWindows(const std::vector<WindowInfo>& windows, const std::vector<WorkspaceInfo>& workspaces);
 
     // T043: Workspace information display helpers
     void displayFocusedWindowInfo(const std::optional<WindowInfo>& focusedWindow, const std::vector<WorkspaceInfo>& workspaces);
-    void displayCrossWorkspaceStatistics(const std::vector<WindowInfo>& allWindows, const std::vector<WorkspaceInfo>& workspaces);
+    void displayCrossWorkspaceStatistics(const WindowSnapshot& snapshot, const std::vector<WorkspaceInfo>& workspaces);
     std::string formatWorkspaceInfo(const WorkspaceInfo& workspace, bool includeIndex = true);
 
     // NEW: Focus command display methods (from contracts/focus_api.md)
@@ -96,14 +100,29 @@ public:
 private:
     std::string outputFormat_ = "text"; // "text" or "json"
     bool verbose_ = false;
+    bool highlightMatches_ = false;
+    std::string etag_;
+
+    // Per-workspace window counts, parallel to the workspace list
+    struct WorkspaceWindowCounts {
+        size_t windows = 0;
+        size_t visible = 0;
+        size_t minimized = 0;
+        size_t focused = 0;
+    };
+    // From the snapshot's membership buckets and state tallies; never walks the windows
+    std::vector<WorkspaceWindowCounts> countWindowsPerWorkspace(
+        const std::vector<WorkspaceInfo>& workspaces, const WorkspaceBuckets* buckets,
+        const std::map<std::string, WindowStateCounts>& stateCounts) const;
 
     // UI formatting constants
     static constexpr size_t DEFAULT_TITLE_TRUNCATE_LENGTH = 50;
     static constexpr int MILLISECONDS_PER_SECOND = 1000;
 
     // Text output helpers
-    void displayWindowsAsText(const std::vector<WindowInfo>& windows);
-    void displayWindowAsText(const WindowInfo& window, int index = -1);
+    void displayWindowsAsText(const std::vector<WindowInfo>& windows, const SearchQuery* highlightQuery = nullptr);
+    void displayWindowAsText(const WindowInfo& window, int index = -1, const SearchQuery* highlightQuery = nullptr);
+    std::string highlightMatches(const std::string& text, SearchField textField, const SearchQuery& query) const;
     void displayWindowsWithHandlesAsText(const std::vector<WindowInfo>& windows);
 
     // NEW: Workspace-aware text output helpers (T030)
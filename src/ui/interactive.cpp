@@ -18,12 +18,38 @@ InteractiveUI::InteractiveUI(std::unique_ptr<WindowManager> windowManager)
         throw std::invalid_argument("InteractiveUI requires a valid WindowManager");
     }
 
+    // Keystrokes must never wait for an expired cache to be re-enumerated
+    windowManager_->setStaleWhileRevalidate(true);
+
+    auto initialFrame = std::make_shared<DisplayFrame>();
+    initialFrame->result = std::make_shared<const FilterResult>();
+    currentFrame_ = std::move(initialFrame);
+
+    redrawScheduler_ = std::make_unique<RedrawScheduler>(
+        [this]() { screen_.PostEvent(Event::Custom); });
+
+    previewWorker_ = std::make_unique<PreviewWorker>(
+        [this](const std::string& handle, unsigned int maxWidth, unsigned int maxHeight) {
+            return windowManager_->captureThumbnail(handle, maxWidth, maxHeight);
+        },
+        [this]() { redrawScheduler_->requestRedraw(); });
+
+    searchExecutor_ = std::make_unique<SearchExecutor>(
+        [this](const SearchQuery& query) { return executeSearch(query); },
+        [this](FilterResult&& result, uint64_t generation) {
+            onSearchCompleted(std::move(result), generation);
+        },
+        SEARCH_DEBOUNCE_INTERVAL);
+
     // Initialize with empty search
     performSearch();
 }
 
 InteractiveUI::~InteractiveUI() {
     stopBackgroundRefresh();
+    searchExecutor_.reset();
+    previewWorker_.reset();
+    redrawScheduler_.reset();
 }
 
 int InteractiveUI::run() {
@@ -46,24 +72,34 @@ void InteractiveUI::setRefreshInterval(std::chrono::milliseconds interval) {
     refreshInterval_ = interval;
 }
 
+void InteractiveUI::setStayOpenAfterFocus(bool stayOpen) {
+    stayOpenAfterFocus_ = stayOpen;
+}
+
+void InteractiveUI::setMaxFrameRate(unsigned int maxFrameRate) {
+    redrawScheduler_->setMaxFrameRate(maxFrameRate);
+}
+
 void InteractiveUI::setCaseSensitive(bool caseSensitive) {
     caseSensitive_ = caseSensitive;
     performSearch(); // Re-search with new setting
 }
 
 Component InteractiveUI::createMainComponent() {
-    // Create search input component
-    auto searchComponent = Input(&searchInput_, "Enter search keyword...");
+    // Create search input component; edits are forwarded to the debounced search worker
+    InputOption inputOption;
+    inputOption.on_change = [this]() { onSearchInputChange(); };
+    auto searchComponent = Input(&searchInput_, "Enter search keyword...", inputOption);
 
     // Add search input event handler
     searchComponent |= CatchEvent([this](Event event) {
+        // Every handled event is followed by a redraw - no need for a scheduled one
+        if (event != Event::Custom) {
+            redrawScheduler_->notifyInputRedraw();
+        }
+
         if (event.is_character() || event == Event::Backspace || event == Event::Delete) {
-            // Delay search slightly to avoid too many updates while typing
-            std::thread([this]() {
-                std::this_thread::sleep_for(REFRESH_SLEEP_INTERVAL);
-                onSearchInputChange();
-            }).detach();
-            return false; // Let the input component handle the event first
+            return false; // Let the input component handle the event (triggers on_change)
         }
 
         if (event == Event::F5) {
@@ -71,6 +107,38 @@ Component InteractiveUI::createMainComponent() {
             return true;
         }
 
+        if (event == Event::F2) {
+            onPreviewToggled();
+            return true;
+        }
+
+        if (event == Event::F3) {
+            onPerformanceOverlayToggled();
+            return true;
+        }
+
+        // Selection, scrolling and paging over the full result
+        if (event == Event::ArrowDown) {
+            moveSelection(1);
+            return true;
+        }
+        if (event == Event::ArrowUp) {
+            moveSelection(-1);
+            return true;
+        }
+        if (event == Event::PageDown) {
+            moveSelection(static_cast<long>(getViewportRowCount()));
+            return true;
+        }
+        if (event == Event::PageUp) {
+            moveSelection(-static_cast<long>(getViewportRowCount()));
+            return true;
+        }
+        if (event == Event::Return) {
+            onFocusSelectedRequested();
+            return true;
+        }
+
         if (event == Event::Escape || (event.is_character() && (event.character() == "q" || event.character() == "Q"))) {
             onQuitRequested();
             return true;
@@ -92,7 +160,11 @@ Component InteractiveUI::createMainComponent() {
 
     // Add renderer for the complete UI
     auto renderer = Renderer(container, [this]() {
-        return vbox({
+        // Always render the last complete frame - never wait on enumeration or search
+        auto buildStart = std::chrono::steady_clock::now();
+        auto frame = loadFrame();
+
+        auto document = vbox({
             // Header
             text("Window List and Filter Program - Interactive Mode") | bold | center,
             separator(),
@@ -115,22 +187,32 @@ Component InteractiveUI::createMainComponent() {
 
             separator(),
 
-            // Window list
-            renderWindowList() | flex,
+            // Window list, with the preview pane next to it when enabled
+            previewEnabled_ ?
+                hbox({
+                    renderWindowList(*frame) | flex,
+                    separator(),
+                    renderPreview(*frame),
+                }) | flex :
+                renderWindowList(*frame) | flex,
 
             separator(),
 
             // Status bar
-            renderStatusBar(),
+            renderStatusBar(*frame),
 
             // Performance warning if needed
-            performanceWarning_ ? renderPerformanceWarning() : text(""),
+            frame->performanceWarning ? renderPerformanceWarning() : text(""),
 
             separator(),
 
-            // Help text
-            renderHelp(),
+            // Help text, or the performance overlay when enabled
+            performanceOverlayEnabled_ ? renderPerformanceOverlay() : renderHelp(),
         });
+
+        lastFrameBuildTime_ = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - buildStart);
+        return document;
     });
 
     return renderer;
@@ -140,10 +222,10 @@ Component InteractiveUI::createSearchInput() {
     return Input(&searchInput_, "Enter search keyword...");
 }
 
-Element InteractiveUI::renderWindowList() {
-    std::lock_guard<std::mutex> lock(windowsMutex_);
+Element InteractiveUI::renderWindowList(const DisplayFrame& frame) {
+    const auto& result = *frame.result;
 
-    if (currentResult_.windows.empty()) {
+    if (result.windows.empty()) {
         if (searchInput_.empty()) {
             return vbox({
                 text("No windows found") | center,
@@ -160,43 +242,106 @@ Element InteractiveUI::renderWindowList() {
         }
     }
 
+    // Clamp the viewport to the current result; render cost depends only on its size
+    const size_t total = result.windows.size();
+    const size_t viewportRows = getViewportRowCount();
+    selectedIndex_ = total > 0 ? std::min(selectedIndex_, total - 1) : 0;
+    scrollOffset_ = std::min(scrollOffset_, total > viewportRows ? total - viewportRows : 0);
+    if (selectedIndex_ < scrollOffset_) {
+        scrollOffset_ = selectedIndex_;
+    } else if (selectedIndex_ >= scrollOffset_ + viewportRows) {
+        scrollOffset_ = selectedIndex_ - viewportRows + 1;
+    }
+    const size_t end = std::min(total, scrollOffset_ + viewportRows);
+
     Elements windowElements;
+    windowElements.reserve(end - scrollOffset_ + LIST_HEADER_HEIGHT);
 
     // Add header
     windowElements.push_back(
         hbox({
-            text("Windows (" + std::to_string(currentResult_.filteredCount) +
-                 " of " + std::to_string(currentResult_.totalCount) + ")") | bold,
+            text("Windows (" + std::to_string(result.filteredCount) +
+                 " of " + std::to_string(result.totalCount) + ")") | bold,
+            text("  Showing " + std::to_string(scrollOffset_ + 1) + "-" + std::to_string(end)) | dim,
             filler(),
-            text("Search: " + std::to_string(currentResult_.searchTime.count()) + "ms") | dim,
+            text("Search: " + std::to_string(result.searchTime.count()) + "ms") | dim,
         })
     );
 
     windowElements.push_back(separator());
 
-    // Add windows
-    for (size_t i = 0; i < currentResult_.windows.size() && i < MAX_DISPLAYED_WINDOWS; ++i) {
-        windowElements.push_back(renderWindow(currentResult_.windows[i], static_cast<int>(i + 1)));
+    // Add only the windows inside the viewport, reusing rows that did not change
+    ++renderedFrameCount_;
+    for (size_t i = scrollOffset_; i < end; ++i) {
+        windowElements.push_back(renderCachedWindow(result.windows[i], static_cast<int>(i + 1), i == selectedIndex_, result.query));
     }
+    pruneRowCache();
 
-    // Add "more" indicator if there are many windows
-    if (currentResult_.windows.size() > MAX_DISPLAYED_WINDOWS) {
-        windowElements.push_back(
-            text("... and " + std::to_string(currentResult_.windows.size() - MAX_DISPLAYED_WINDOWS) + " more windows") | dim | center
-        );
+    return vbox(windowElements) | flex | reflect(listBox_);
+}
+
+InteractiveUI::RowCacheKey::RowCacheKey(const WindowInfo& window, int index, bool selected, const SearchQuery& query)
+    : title(window.title)
+    , ownerName(window.ownerName)
+    , x(window.x), y(window.y)
+    , width(window.width), height(window.height)
+    , processId(window.processId)
+    , isVisible(window.isVisible)
+    , index(index)
+    , selected(selected)
+    , query(query.query)
+    , caseSensitive(query.caseSensitive)
+    , useRegex(query.useRegex) {
+}
+
+bool InteractiveUI::RowCacheKey::operator==(const RowCacheKey& other) const {
+    // Cheap fields first; strings are only compared when everything else matches
+    return x == other.x && y == other.y && width == other.width && height == other.height &&
+           processId == other.processId && isVisible == other.isVisible &&
+           index == other.index && selected == other.selected &&
+           caseSensitive == other.caseSensitive && useRegex == other.useRegex &&
+           title == other.title && ownerName == other.ownerName && query == other.query;
+}
+
+Element InteractiveUI::renderCachedWindow(const WindowInfo& window, int index, bool selected, const SearchQuery& query) {
+    RowCacheKey key(window, index, selected, query);
+
+    auto it = rowCache_.find(window.handle);
+    if (it != rowCache_.end() && it->second.key == key) {
+        it->second.lastUsedFrame = renderedFrameCount_;
+        return it->second.element;
+    }
+
+    Element element = renderWindow(window, index, selected, query);
+    rowCache_.insert_or_assign(window.handle, RowCacheEntry{std::move(key), element, renderedFrameCount_});
+    return element;
+}
+
+void InteractiveUI::pruneRowCache() {
+    if (rowCache_.size() <= ROW_CACHE_LIMIT) {
+        return;
     }
 
-    return vbox(windowElements) | flex;
+    // Keep the rows of the current frame; everything else is rebuilt on demand
+    for (auto it = rowCache_.begin(); it != rowCache_.end();) {
+        if (it->second.lastUsedFrame != renderedFrameCount_) {
+            it = rowCache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
-Element InteractiveUI::renderWindow(const WindowInfo& window, int index) {
+Element InteractiveUI::renderWindow(const WindowInfo& window, int index, bool selected, const SearchQuery& query) {
     auto titleColor = getWindowColor(index);
 
-    return vbox({
+    auto row = vbox({
         hbox({
+            text(selected ? "> " : "  ") | bold,
             text("[" + std::to_string(index) + "] ") | color(Color::Blue),
-            text(window.ownerName) | color(titleColor) | bold,
-            window.title.empty() ? text("") : text(" - " + formatWindowTitle(window)) | color(titleColor),
+            renderHighlighted(window.ownerName, SearchField::Owner, query, titleColor) | bold,
+            window.title.empty() ? text("") : text(" - ") | color(titleColor),
+            window.title.empty() ? text("") : renderHighlighted(formatWindowTitle(window), SearchField::Title, query, titleColor),
             filler(),
             window.isVisible ? text("") : text("[Hidden]") | color(Color::Red) | dim,
         }),
@@ -207,19 +352,122 @@ Element InteractiveUI::renderWindow(const WindowInfo& window, int index) {
             filler(),
         }),
     });
+
+    return selected ? row | inverted : row;
 }
 
-Element InteractiveUI::renderStatusBar() {
+Element InteractiveUI::renderHighlighted(const std::string& text, SearchField textField, const SearchQuery& query,
+                                         Color baseColor) const {
+    // Spans are computed here, per rendered row, so the cost scales with the viewport
+    auto spans = query.findMatchSpans(text, textField);
+    if (spans.empty()) {
+        return ftxui::text(text) | color(baseColor);
+    }
+
+    Elements parts;
+    size_t position = 0;
+    for (const auto& span : spans) {
+        if (span.offset > position) {
+            parts.push_back(ftxui::text(text.substr(position, span.offset - position)) | color(baseColor));
+        }
+        parts.push_back(ftxui::text(text.substr(span.offset, span.length)) | color(Color::Yellow) | bold | underlined);
+        position = span.offset + span.length;
+    }
+    if (position < text.size()) {
+        parts.push_back(ftxui::text(text.substr(position)) | color(baseColor));
+    }
+
+    return hbox(std::move(parts));
+}
+
+Element InteractiveUI::renderPreview(const DisplayFrame& frame) {
+    Elements lines;
+    lines.push_back(text("Preview") | bold);
+
+    const auto& windows = frame.result->windows;
+    if (selectedIndex_ >= windows.size()) {
+        previewWorker_->cancel();
+        lines.push_back(text("No window selected") | dim);
+        return vbox(std::move(lines)) | size(WIDTH, EQUAL, PREVIEW_COLUMNS);
+    }
+
+    // Non-blocking: the worker captures in the background and triggers a redraw when ready
+    const WindowInfo& window = windows[selectedIndex_];
+    previewWorker_->request(window.handle, PREVIEW_COLUMNS, PREVIEW_ROWS * 2);
+
+    auto thumbnail = previewWorker_->getThumbnail(window.handle);
+    if (!thumbnail) {
+        lines.push_back(text("Waiting for capture...") | dim);
+        return vbox(std::move(lines)) | size(WIDTH, EQUAL, PREVIEW_COLUMNS);
+    }
+
+    auto toColor = [](uint32_t pixel) {
+        return Color::RGB((pixel >> 16) & 0xFF, (pixel >> 8) & 0xFF, pixel & 0xFF);
+    };
+
+    // Half blocks: foreground paints the upper pixel, background the lower one
+    for (unsigned int y = 0; y < thumbnail->height; y += 2) {
+        Elements cells;
+        cells.reserve(thumbnail->width);
+        for (unsigned int x = 0; x < thumbnail->width; ++x) {
+            uint32_t upper = thumbnail->pixelAt(x, y);
+            uint32_t lower = y + 1 < thumbnail->height ? thumbnail->pixelAt(x, y + 1) : 0;
+            cells.push_back(text("▀") | color(toColor(upper)) | bgcolor(toColor(lower)));
+        }
+        lines.push_back(hbox(std::move(cells)));
+    }
+
+    return vbox(std::move(lines)) | size(WIDTH, EQUAL, PREVIEW_COLUMNS);
+}
+
+Element InteractiveUI::renderPerformanceOverlay() {
+    auto metrics = windowManager_->getPerformanceMetrics();
+
+    auto formatMs = [](std::chrono::microseconds duration) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << duration.count() / 1000.0 << "ms";
+        return oss.str();
+    };
+    std::ostringstream hitRate;
+    hitRate << std::fixed << std::setprecision(1) << metrics.filterCacheHitRatio * 100 << "%";
+
+    return vbox({
+        text("Performance (F3 to hide)") | bold,
+        text("  Frame build: " + formatMs(lastFrameBuildTime_) +
+             "  Redraws: " + std::to_string(redrawScheduler_->getRedrawCount()) +
+             " of " + std::to_string(redrawScheduler_->getRequestCount()) + " requested"),
+        text("  Search latency p50/p95/p99: " + formatMs(metrics.searchLatencyP50) + " / " +
+             formatMs(metrics.searchLatencyP95) + " / " + formatMs(metrics.searchLatencyP99) +
+             " (" + std::to_string(metrics.searchSampleCount) + " searches)"),
+        text("  Enumeration: " + std::to_string(metrics.windowEnumerationTime.count()) + "ms, " +
+             std::to_string(metrics.lastRefreshServerRequests) + " X round trips, " +
+             std::to_string(metrics.totalWindowCount) + " windows"),
+        text("  Filter cache hit rate: " + hitRate.str() +
+             "  Snapshot memory: " + std::to_string(metrics.snapshotMemoryBytes / 1024) + " KiB"),
+        text("  Cache TTL: " + std::to_string(metrics.effectiveCacheTtl.count()) + "ms" +
+             (metrics.adaptiveCacheTtl ? " (adaptive, " + std::to_string(static_cast<int>(
+                                             metrics.observedChangeRate * 100)) + "% of refreshes changed)"
+                                       : " (fixed)")),
+        text("  Title changes: " + std::to_string(metrics.titleChangesDelivered) + " of " +
+             std::to_string(metrics.titleChangesReceived) + " delivered (" +
+             std::to_string(static_cast<int>(metrics.titleCoalescingRatio * 100)) + "% coalesced)"),
+    }) | color(Color::Cyan);
+}
+
+Element InteractiveUI::renderStatusBar(const DisplayFrame& frame) {
     auto now = std::chrono::steady_clock::now();
-    auto timeSinceRefresh = std::chrono::duration_cast<std::chrono::seconds>(now - lastSearchTime_);
+    auto timeSinceRefresh = std::chrono::duration_cast<std::chrono::seconds>(now - frame.lastSearchTime);
 
     return hbox({
         text("Status: "),
-        refreshEnabled_ ? text("Auto-refresh ON") | color(Color::Green) : text("Auto-refresh OFF") | color(Color::Red),
+        !refreshEnabled_ ? text("Auto-refresh OFF") | color(Color::Red) :
+            windowManager_->supportsChangeNotifications() ? text("Live updates ON") | color(Color::Green) :
+            text("Auto-refresh ON") | color(Color::Green),
         text(" | "),
         text("Last refresh: " + std::to_string(timeSinceRefresh.count()) + "s ago") | dim,
+        focusMessage_.empty() ? text("") : text(" | " + focusMessage_) | color(Color::Yellow),
         filler(),
-        text("F5: Refresh | C: Toggle case | ESC/Q: Quit") | dim,
+        text("F5: Refresh | ↑/↓ PgUp/PgDn: Select | Enter: Focus | ESC: Quit") | dim,
     });
 }
 
@@ -228,6 +476,10 @@ Element InteractiveUI::renderHelp() {
         text("Controls:") | bold,
         text("  Type to search windows in real-time"),
         text("  F5 - Manual refresh"),
+        text("  Up/Down, PgUp/PgDn - Select a window (scrolls through all results)"),
+        text("  Enter - Focus the selected window"),
+        text("  F2 - Toggle live preview of the selected window"),
+        text("  F3 - Toggle performance overlay"),
         text("  C - Toggle case sensitivity"),
         text("  ESC or Q - Quit"),
     }) | dim;
@@ -241,14 +493,96 @@ Element InteractiveUI::renderPerformanceWarning() {
 }
 
 void InteractiveUI::onSearchInputChange() {
-    performSearch();
-    screen_.PostEvent(Event::Custom); // Trigger screen refresh
+    // A new query starts at the top of its results
+    scrollOffset_ = 0;
+    selectedIndex_ = 0;
+
+    // Debounced: a burst of keystrokes results in a single search
+    searchExecutor_->submit(publishSearchQuery());
 }
 
 void InteractiveUI::onRefreshRequested() {
-    updateWindowList();
-    performSearch();
-    screen_.PostEvent(Event::Custom); // Trigger screen refresh
+    // Rendering never waits on enumeration: the refresh thread does it and publishes the frame
+    refreshRequested_ = true;
+    windowManager_->interruptWaitForChanges();
+}
+
+void InteractiveUI::moveSelection(long rows) {
+    // The renderer scrolls the viewport so that the selection stays visible
+    const size_t total = loadFrame()->result->windows.size();
+    if (total == 0) {
+        selectedIndex_ = 0;
+        return;
+    }
+
+    if (rows < 0) {
+        size_t step = static_cast<size_t>(-rows);
+        selectedIndex_ = selectedIndex_ > step ? selectedIndex_ - step : 0;
+    } else {
+        selectedIndex_ = std::min(total - 1, selectedIndex_ + static_cast<size_t>(rows));
+    }
+}
+
+void InteractiveUI::onFocusSelectedRequested() {
+    auto frame = loadFrame();
+    const auto& windows = frame->result->windows;
+    if (selectedIndex_ >= windows.size()) {
+        return;
+    }
+
+    // Focusing talks to X (and may sleep through a desktop switch), so it runs on the
+    // refresh thread, serialised with enumeration; the UI keeps rendering meanwhile
+    {
+        std::lock_guard<std::mutex> lock(focusRequestMutex_);
+        pendingFocus_ = windows[selectedIndex_];
+    }
+    focusMessage_ = "Focusing " + windows[selectedIndex_].handle + "...";
+    windowManager_->interruptWaitForChanges();
+}
+
+void InteractiveUI::focusPendingWindow() {
+    std::optional<WindowInfo> window;
+    {
+        std::lock_guard<std::mutex> lock(focusRequestMutex_);
+        window.swap(pendingFocus_);
+    }
+    if (!window) {
+        return;
+    }
+
+    // Reuse the warm session: the displayed snapshot is recent enough to skip validation
+    bool focused = windowManager_->focusWindowFromSnapshot(*window);
+    screen_.Post([this, handle = window->handle, focused]() {
+        if (!focused) {
+            focusMessage_ = "Failed to focus " + handle;
+            return;
+        }
+        if (!stayOpenAfterFocus_) {
+            onQuitRequested();
+            return;
+        }
+        focusMessage_ = "Focused " + handle;
+    });
+    redrawScheduler_->requestRedraw();
+}
+
+size_t InteractiveUI::getViewportRowCount() const {
+    const int height = listBox_.y_max - listBox_.y_min + 1;
+    if (height <= static_cast<int>(LIST_HEADER_HEIGHT + WINDOW_ROW_HEIGHT)) {
+        return DEFAULT_VIEWPORT_ROWS;
+    }
+    return (static_cast<size_t>(height) - LIST_HEADER_HEIGHT) / WINDOW_ROW_HEIGHT;
+}
+
+void InteractiveUI::onPreviewToggled() {
+    previewEnabled_ = !previewEnabled_;
+    if (!previewEnabled_) {
+        previewWorker_->cancel(); // No captures while the pane is hidden
+    }
+}
+
+void InteractiveUI::onPerformanceOverlayToggled() {
+    performanceOverlayEnabled_ = !performanceOverlayEnabled_;
 }
 
 void InteractiveUI::onQuitRequested() {
@@ -263,59 +597,118 @@ void InteractiveUI::startBackgroundRefresh() {
 
 void InteractiveUI::stopBackgroundRefresh() {
     refreshEnabled_ = false;
+    windowManager_->interruptWaitForChanges();
     if (refreshThread_.joinable()) {
         refreshThread_.join();
     }
 }
 
 void InteractiveUI::backgroundRefreshLoop() {
+    // Event-driven when the platform reports window changes, otherwise poll every refreshInterval_
+    const bool eventDriven = windowManager_->supportsChangeNotifications();
+    const auto waitSlice = eventDriven ? CHANGE_WAIT_SLICE : refreshInterval_;
+    std::chrono::steady_clock::time_point lastRefresh;
+
     while (refreshEnabled_) {
-        std::this_thread::sleep_for(refreshInterval_);
+        // Idle here until something changes or the UI interrupts the wait (F5, shutdown)
+        bool changed = windowManager_->waitForChanges(waitSlice);
 
         if (!refreshEnabled_) break;
 
-        updateWindowList();
-        performSearch();
-
-        // Post event to refresh the screen
-        if (refreshEnabled_) {
-            screen_.PostEvent(Event::Custom);
+        focusPendingWindow();
+
+        bool requested = refreshRequested_.exchange(false);
+        if (requested) {
+            windowManager_->invalidateCache(); // F5 wants fresh data, not the cached list
+        } else if (!changed) {
+            continue;
+        } else if (eventDriven) {
+            // Coalesce bursts (e.g. browser title spam) into at most one refresh per
+            // frame interval; notifications arriving meanwhile are folded into it
+            auto nextAllowed = lastRefresh + FRAME_INTERVAL;
+            auto now = std::chrono::steady_clock::now();
+            if (now < nextAllowed) {
+                std::this_thread::sleep_for(nextAllowed - now);
+            }
+            windowManager_->waitForChanges(std::chrono::milliseconds(0));
         }
+
+        updateWindowList();
+        repeatSearch(); // Completion posts the screen refresh
+        lastRefresh = std::chrono::steady_clock::now();
     }
 }
 
 void InteractiveUI::updateWindowList() {
     try {
-        std::lock_guard<std::mutex> lock(windowsMutex_);
-        allWindows_ = windowManager_->getAllWindows();
+        // Enumerate here rather than on the search worker, so typing never waits on it.
+        // Frames come from the search result alone; no copy of the list is kept.
+        windowManager_->getSnapshot();
     } catch (const std::exception&) {
         // Silently handle errors in background refresh
         // The user can manually refresh if needed
     }
 }
 
-void InteractiveUI::performSearch() {
-    auto startTime = std::chrono::steady_clock::now();
+std::shared_ptr<const DisplayFrame> InteractiveUI::loadFrame() const {
+    return std::atomic_load(&currentFrame_);
+}
 
-    try {
-        std::lock_guard<std::mutex> lock(windowsMutex_);
+void InteractiveUI::publishFrame(std::shared_ptr<const DisplayFrame> frame) {
+    std::atomic_store(&currentFrame_, std::move(frame));
+}
 
-        auto query = createSearchQuery();
-        currentResult_ = windowManager_->searchWindows(query);
+void InteractiveUI::performSearch() {
+    // Explicit searches (option changes) skip the typing debounce
+    searchExecutor_->submitImmediate(publishSearchQuery());
+}
 
-        lastSearchTime_ = startTime;
-        performanceWarning_ = !currentResult_.meetsPerformanceTarget();
+void InteractiveUI::repeatSearch() {
+    searchExecutor_->submitImmediate(getSearchQuery());
+}
 
+FilterResult InteractiveUI::executeSearch(const SearchQuery& query) {
+    // Runs on the search worker thread
+    try {
+        return windowManager_->searchWindows(query);
     } catch (const std::exception&) {
         // Create empty result on error
-        auto query = createSearchQuery();
-        currentResult_ = windowManager_->getEmptyResult(query);
-        performanceWarning_ = false;
+        return windowManager_->getEmptyResult(query);
     }
 }
 
-SearchQuery InteractiveUI::createSearchQuery() const {
-    return SearchQuery(searchInput_, SearchField::Both, caseSensitive_, false);
+void InteractiveUI::onSearchCompleted(FilterResult&& result, uint64_t generation) {
+    {
+        std::lock_guard<std::mutex> lock(framePublishMutex_);
+        auto previous = loadFrame();
+
+        // Results can only move forward - never replace a newer query's result
+        if (generation < previous->searchGeneration) {
+            return;
+        }
+
+        // Build the next frame off to the side, then swap it in
+        auto next = std::make_shared<DisplayFrame>();
+        next->performanceWarning = !result.meetsPerformanceTarget();
+        next->result = std::make_shared<const FilterResult>(std::move(result));
+        next->searchGeneration = generation;
+        next->lastSearchTime = std::chrono::steady_clock::now();
+        publishFrame(std::move(next));
+    }
+
+    redrawScheduler_->requestRedraw(); // Coalesced with other updates in the same frame
+}
+
+SearchQuery InteractiveUI::publishSearchQuery() {
+    SearchQuery query(searchInput_, SearchField::Both, caseSensitive_, false);
+    std::lock_guard<std::mutex> lock(searchQueryMutex_);
+    searchQuery_ = query;
+    return query;
+}
+
+SearchQuery InteractiveUI::getSearchQuery() const {
+    std::lock_guard<std::mutex> lock(searchQueryMutex_);
+    return searchQuery_;
 }
 
 std::string InteractiveUI::formatWindowTitle(const WindowInfo& window, size_t maxLength) const {
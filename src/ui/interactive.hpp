@@ -3,6 +3,9 @@
 #include "../core/window_manager.hpp"
 #include "../filters/search_query.hpp"
 #include "../filters/filter_result.hpp"
+#include "search_executor.hpp"
+#include "redraw_scheduler.hpp"
+#include "preview_worker.hpp"
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 #include <ftxui/dom/elements.hpp>
@@ -11,10 +14,23 @@
 #include <vector>
 #include <atomic>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <unordered_map>
 
 namespace WindowManager {
 
+/**
+ * Immutable snapshot of everything the renderer needs
+ * Built off the UI thread and published with an atomic pointer swap
+ */
+struct DisplayFrame {
+    std::shared_ptr<const FilterResult> result; // Windows and counts from one search over one snapshot
+    uint64_t searchGeneration = 0;
+    std::chrono::steady_clock::time_point lastSearchTime;
+    bool performanceWarning = false;
+};
+
 /**
  * Interactive terminal interface using FTXUI
  * Provides real-time window filtering with live search
@@ -36,35 +52,93 @@ public:
     // Configuration
     void setRefreshInterval(std::chrono::milliseconds interval);
     void setCaseSensitive(bool caseSensitive);
+    void setStayOpenAfterFocus(bool stayOpen); // Default: exit once a window has been focused
+    void setMaxFrameRate(unsigned int maxFrameRate); // Caps background-triggered redraws (0 = uncapped)
 
 private:
     // Core components
     std::unique_ptr<WindowManager> windowManager_;
     ftxui::ScreenInteractive screen_;
 
-    // UI state
+    // UI state (UI thread only; other threads read the published query below)
     std::string searchInput_;
     bool caseSensitive_ = false;
     bool shouldExit_ = false;
+    bool stayOpenAfterFocus_ = false;
+    std::string focusMessage_; // Outcome of the last Enter-to-focus, shown in the status bar
+
+    // The query, published by the UI thread whenever the input or the case option changes;
+    // the refresh thread re-runs this copy instead of reading the fields above
+    mutable std::mutex searchQueryMutex_;
+    SearchQuery searchQuery_;
 
     // Background refresh state
     std::atomic<bool> refreshEnabled_ = true;
+    std::atomic<bool> refreshRequested_ = false; // F5; served by the refresh thread, never the UI thread
+    std::mutex focusRequestMutex_;
+    std::optional<WindowInfo> pendingFocus_;      // Enter; focused by the refresh thread as well
     std::chrono::milliseconds refreshInterval_ = std::chrono::milliseconds(1000);
     std::thread refreshThread_;
-    mutable std::mutex windowsMutex_;
+
+    // Virtualized result list: only rows inside the viewport are built
+    size_t scrollOffset_ = 0;
+    size_t selectedIndex_ = 0; // Index into the current result, kept inside the viewport
+    ftxui::Box listBox_; // Area the list occupied in the last frame
+
+    // Memoized row elements: a row is rebuilt only when something it displays changes
+    struct RowCacheKey {
+        std::string title;
+        std::string ownerName;
+        int x = 0, y = 0;
+        unsigned int width = 0, height = 0;
+        unsigned int processId = 0;
+        bool isVisible = false;
+        int index = 0;            // Row number and color
+        bool selected = false;
+        std::string query;        // Determines the highlight spans
+        bool caseSensitive = false;
+        bool useRegex = false;
+
+        RowCacheKey(const WindowInfo& window, int index, bool selected, const SearchQuery& query);
+        bool operator==(const RowCacheKey& other) const;
+    };
+    struct RowCacheEntry {
+        RowCacheKey key;
+        ftxui::Element element;
+        uint64_t lastUsedFrame;
+    };
+    std::unordered_map<std::string, RowCacheEntry> rowCache_; // Keyed by window handle, UI thread only
+    uint64_t renderedFrameCount_ = 0;
 
     // UI display constants
-    static constexpr size_t MAX_DISPLAYED_WINDOWS = 20;
+    static constexpr size_t WINDOW_ROW_HEIGHT = 2;        // Lines per rendered window
+    static constexpr size_t LIST_HEADER_HEIGHT = 2;       // Count line + separator
+    static constexpr size_t DEFAULT_VIEWPORT_ROWS = 10;   // Until the first frame has been laid out
     static constexpr size_t DEFAULT_WINDOW_TITLE_LENGTH = 60;
-    static constexpr std::chrono::milliseconds REFRESH_SLEEP_INTERVAL{100};
+    static constexpr size_t ROW_CACHE_LIMIT = 256;         // Rows kept beyond the visible ones
+    static constexpr unsigned int PREVIEW_COLUMNS = 40;     // Preview pane width in cells
+    static constexpr unsigned int PREVIEW_ROWS = 12;        // Two pixels per cell (half blocks)
+    static constexpr std::chrono::milliseconds SEARCH_DEBOUNCE_INTERVAL{100};
+    static constexpr std::chrono::milliseconds FRAME_INTERVAL{16};      // Change bursts coalesce into one refresh per frame
+    static constexpr std::chrono::milliseconds CHANGE_WAIT_SLICE{250};  // Bounds shutdown latency while idle
+
+    // Last complete frame; read lock-free by the renderer (std::atomic_load/atomic_store)
+    std::shared_ptr<const DisplayFrame> currentFrame_;
+    std::mutex framePublishMutex_; // Serializes publishers only, never taken while rendering
+
+    // Debounced search worker; results carry the query generation they answer
+    std::unique_ptr<SearchExecutor> searchExecutor_;
+
+    // Coalesces background redraw requests and caps them at the configured frame rate
+    std::unique_ptr<RedrawScheduler> redrawScheduler_;
 
-    // Cached data
-    std::vector<WindowInfo> allWindows_;
-    FilterResult currentResult_;
+    // Optional preview pane (F2); captures run on the preview worker, never on the UI thread
+    bool previewEnabled_ = false;
+    std::unique_ptr<PreviewWorker> previewWorker_;
 
-    // Performance tracking
-    std::chrono::steady_clock::time_point lastSearchTime_;
-    bool performanceWarning_ = false;
+    // Performance overlay (F3); frame build time is measured on the UI thread
+    bool performanceOverlayEnabled_ = false;
+    std::chrono::microseconds lastFrameBuildTime_{0};
 
     // UI Components
     ftxui::Component createMainComponent();
@@ -74,26 +148,46 @@ private:
     ftxui::Component createHelpText();
 
     // Content generators
-    ftxui::Element renderWindowList();
-    ftxui::Element renderWindow(const WindowInfo& window, int index);
-    ftxui::Element renderStatusBar();
+    ftxui::Element renderWindowList(const DisplayFrame& frame);
+    ftxui::Element renderWindow(const WindowInfo& window, int index, bool selected, const SearchQuery& query);
+    ftxui::Element renderCachedWindow(const WindowInfo& window, int index, bool selected, const SearchQuery& query);
+    void pruneRowCache();
+    ftxui::Element renderHighlighted(const std::string& text, SearchField textField, const SearchQuery& query,
+                                     ftxui::Color baseColor) const;
+    ftxui::Element renderStatusBar(const DisplayFrame& frame);
     ftxui::Element renderHelp();
     ftxui::Element renderPerformanceWarning();
+    ftxui::Element renderPreview(const DisplayFrame& frame);
+    ftxui::Element renderPerformanceOverlay();
 
     // Event handlers
     void onSearchInputChange();
     void onRefreshRequested();
     void onQuitRequested();
+    void moveSelection(long rows);
+    void onFocusSelectedRequested();
+    void onPreviewToggled();
+    void onPerformanceOverlayToggled();
+    void onSearchCompleted(FilterResult&& result, uint64_t generation);
 
     // Background operations
     void startBackgroundRefresh();
     void stopBackgroundRefresh();
     void backgroundRefreshLoop();
-    void updateWindowList();
+    void focusPendingWindow(); // Refresh thread; reports back to the UI thread through screen_.Post()
+    void updateWindowList(); // Refreshes the snapshot the next search reads
+    std::shared_ptr<const DisplayFrame> loadFrame() const;
+    void publishFrame(std::shared_ptr<const DisplayFrame> frame);
 
     // Search and filtering
-    void performSearch();
-    SearchQuery createSearchQuery() const;
+    void performSearch();                // UI thread
+    void repeatSearch();                 // Any thread: the published query, against fresh windows
+    FilterResult executeSearch(const SearchQuery& query);
+    SearchQuery publishSearchQuery();    // UI thread
+    SearchQuery getSearchQuery() const;
+
+    // Viewport helpers
+    size_t getViewportRowCount() const;
 
     // Utility methods
     std::string formatWindowTitle(const WindowInfo& window, size_t maxLength = DEFAULT_WINDOW_TITLE_LENGTH) const;
@@ -0,0 +1,131 @@
+#include "preview_worker.hpp"
+#include <iterator>
+#include <stdexcept>
+
+namespace WindowManager {
+
+PreviewWorker::PreviewWorker(CaptureFunction capture, ReadyCallback onReady,
+                             std::chrono::milliseconds captureInterval)
+    : capture_(std::move(capture))
+    , onReady_(std::move(onReady))
+    , captureInterval_(captureInterval) {
+
+    if (!capture_ || !onReady_) {
+        throw std::invalid_argument("PreviewWorker requires a capture function and a ready callback");
+    }
+
+    worker_ = std::thread(&PreviewWorker::workerLoop, this);
+}
+
+PreviewWorker::~PreviewWorker() {
+    stop();
+}
+
+void PreviewWorker::request(const std::string& handle, unsigned int maxWidth, unsigned int maxHeight) {
+    Target target{handle, maxWidth, maxHeight};
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (target_ && *target_ == target) {
+            return; // Called every frame - only a new selection wakes the worker
+        }
+        target_ = std::move(target);
+    }
+    condition_.notify_all();
+}
+
+void PreviewWorker::cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    target_.reset();
+}
+
+std::shared_ptr<const WindowThumbnail> PreviewWorker::getThumbnail(const std::string& handle) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(handle);
+    return it != cache_.end() ? it->second : nullptr;
+}
+
+void PreviewWorker::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        target_.reset();
+    }
+    condition_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+size_t PreviewWorker::getCaptureCount() const {
+    return captures_.load();
+}
+
+void PreviewWorker::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || target_.has_value(); });
+        if (stopping_) {
+            break;
+        }
+
+        // Rate limit per window: a selection that was captured recently waits for its turn
+        Target target = *target_;
+        auto attempt = lastAttempt_.find(target.handle);
+        if (attempt != lastAttempt_.end()) {
+            auto due = attempt->second + captureInterval_;
+            if (std::chrono::steady_clock::now() < due) {
+                condition_.wait_until(lock, due, [&]() {
+                    return stopping_ || !target_ || !(*target_ == target);
+                });
+                continue; // Re-evaluate: the selection may have changed meanwhile
+            }
+        }
+        if (lastAttempt_.size() > MAX_CACHED_THUMBNAILS * 4) {
+            // Forget windows that never produced a thumbnail
+            for (auto it = lastAttempt_.begin(); it != lastAttempt_.end();) {
+                it = cache_.count(it->first) ? std::next(it) : lastAttempt_.erase(it);
+            }
+        }
+        lastAttempt_[target.handle] = std::chrono::steady_clock::now();
+
+        lock.unlock();
+
+        std::shared_ptr<const WindowThumbnail> thumbnail;
+        try {
+            auto captured = capture_(target.handle, target.maxWidth, target.maxHeight);
+            if (captured) {
+                thumbnail = std::make_shared<const WindowThumbnail>(std::move(*captured));
+            }
+        } catch (const std::exception&) {
+            // Treated like an unsupported capture; retried after the interval
+        }
+        ++captures_;
+
+        lock.lock();
+        if (thumbnail) {
+            storeThumbnail(std::move(thumbnail));
+            lock.unlock();
+            onReady_();
+            lock.lock();
+        }
+    }
+}
+
+void PreviewWorker::storeThumbnail(std::shared_ptr<const WindowThumbnail> thumbnail) {
+    // Bounded cache: evict the oldest capture
+    if (cache_.size() >= MAX_CACHED_THUMBNAILS && cache_.find(thumbnail->handle) == cache_.end()) {
+        auto oldest = cache_.begin();
+        for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+            if (it->second->capturedAt < oldest->second->capturedAt) {
+                oldest = it;
+            }
+        }
+        lastAttempt_.erase(oldest->first);
+        cache_.erase(oldest);
+    }
+    cache_[thumbnail->handle] = std::move(thumbnail);
+}
+
+} // namespace WindowManager
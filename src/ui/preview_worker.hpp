@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../core/thumbnail.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace WindowManager {
+
+/**
+ * Background window preview capture
+ * Keeps re-capturing the requested window at a bounded rate and caches the latest
+ * thumbnail per window; the UI thread only ever reads the cache
+ */
+class PreviewWorker {
+public:
+    using CaptureFunction = std::function<std::optional<WindowThumbnail>(const std::string&, unsigned int, unsigned int)>;
+    using ReadyCallback = std::function<void()>;
+
+    static constexpr std::chrono::milliseconds DEFAULT_CAPTURE_INTERVAL{500};
+    static constexpr size_t MAX_CACHED_THUMBNAILS = 32;
+
+    PreviewWorker(CaptureFunction capture, ReadyCallback onReady,
+                  std::chrono::milliseconds captureInterval = DEFAULT_CAPTURE_INTERVAL);
+    ~PreviewWorker();
+
+    // Non-copyable, non-moveable (owns the worker thread)
+    PreviewWorker(const PreviewWorker&) = delete;
+    PreviewWorker& operator=(const PreviewWorker&) = delete;
+    PreviewWorker(PreviewWorker&&) = delete;
+    PreviewWorker& operator=(PreviewWorker&&) = delete;
+
+    // Non-blocking: selects the window to keep previewing (size in pixels)
+    void request(const std::string& handle, unsigned int maxWidth, unsigned int maxHeight);
+    void cancel(); // Stop capturing until the next request
+
+    // Latest cached capture of the window, or nullptr
+    std::shared_ptr<const WindowThumbnail> getThumbnail(const std::string& handle) const;
+
+    // Stops the worker
+    void stop();
+
+    // Diagnostics
+    size_t getCaptureCount() const;
+
+private:
+    struct Target {
+        std::string handle;
+        unsigned int maxWidth = 0;
+        unsigned int maxHeight = 0;
+
+        bool operator==(const Target& other) const {
+            return handle == other.handle && maxWidth == other.maxWidth && maxHeight == other.maxHeight;
+        }
+    };
+
+    CaptureFunction capture_;
+    ReadyCallback onReady_;
+    std::chrono::milliseconds captureInterval_;
+
+    // Shared state (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::optional<Target> target_;
+    std::unordered_map<std::string, std::shared_ptr<const WindowThumbnail>> cache_;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> lastAttempt_;
+    bool stopping_ = false;
+
+    std::atomic<size_t> captures_{0};
+
+    std::thread worker_;
+
+    void workerLoop();
+    void storeThumbnail(std::shared_ptr<const WindowThumbnail> thumbnail);
+};
+
+} // namespace WindowManager
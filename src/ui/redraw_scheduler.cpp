@@ -0,0 +1,113 @@
+#include "redraw_scheduler.hpp"
+#include <stdexcept>
+
+namespace WindowManager {
+
+RedrawScheduler::RedrawScheduler(RedrawFunction redraw, unsigned int maxFrameRate)
+    : redraw_(std::move(redraw))
+    , frameInterval_(intervalForRate(maxFrameRate)) {
+
+    if (!redraw_) {
+        throw std::invalid_argument("RedrawScheduler requires a redraw function");
+    }
+
+    worker_ = std::thread(&RedrawScheduler::workerLoop, this);
+}
+
+RedrawScheduler::~RedrawScheduler() {
+    stop();
+}
+
+void RedrawScheduler::requestRedraw() {
+    ++requests_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_) {
+            return; // Already scheduled - coalesced into the next frame
+        }
+        pending_ = true;
+    }
+    condition_.notify_all();
+}
+
+void RedrawScheduler::notifyInputRedraw() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = false;
+    lastRedraw_ = std::chrono::steady_clock::now();
+}
+
+void RedrawScheduler::setMaxFrameRate(unsigned int maxFrameRate) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frameInterval_ = intervalForRate(maxFrameRate);
+    }
+    condition_.notify_all();
+}
+
+std::chrono::microseconds RedrawScheduler::getFrameInterval() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frameInterval_;
+}
+
+void RedrawScheduler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        pending_ = false;
+    }
+    condition_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+uint64_t RedrawScheduler::getRequestCount() const {
+    return requests_.load();
+}
+
+uint64_t RedrawScheduler::getRedrawCount() const {
+    return redraws_.load();
+}
+
+std::chrono::microseconds RedrawScheduler::intervalForRate(unsigned int maxFrameRate) {
+    if (maxFrameRate == 0) {
+        return std::chrono::microseconds(0);
+    }
+    return std::chrono::microseconds(1000000 / maxFrameRate);
+}
+
+void RedrawScheduler::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || pending_; });
+        if (stopping_) {
+            break;
+        }
+
+        // Hold the request until the frame budget allows another redraw;
+        // everything requested meanwhile is served by that single redraw
+        auto nextFrame = lastRedraw_ + frameInterval_;
+        while (!stopping_ && pending_ && std::chrono::steady_clock::now() < nextFrame) {
+            condition_.wait_until(lock, nextFrame);
+            nextFrame = lastRedraw_ + frameInterval_;
+        }
+        if (stopping_) {
+            break;
+        }
+        if (!pending_) {
+            continue; // An input redraw already covered it
+        }
+
+        pending_ = false;
+        lastRedraw_ = std::chrono::steady_clock::now();
+        ++redraws_;
+
+        lock.unlock();
+        redraw_();
+        lock.lock();
+    }
+}
+
+} // namespace WindowManager
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace WindowManager {
+
+/**
+ * Frame-rate capped screen invalidation
+ * Coalesces redraw requests from background threads into at most one redraw
+ * per frame interval; user input redraws immediately and resets the interval
+ */
+class RedrawScheduler {
+public:
+    using RedrawFunction = std::function<void()>;
+
+    static constexpr unsigned int DEFAULT_MAX_FRAME_RATE = 60;
+
+    explicit RedrawScheduler(RedrawFunction redraw, unsigned int maxFrameRate = DEFAULT_MAX_FRAME_RATE);
+    ~RedrawScheduler();
+
+    // Non-copyable, non-moveable (owns the worker thread)
+    RedrawScheduler(const RedrawScheduler&) = delete;
+    RedrawScheduler& operator=(const RedrawScheduler&) = delete;
+    RedrawScheduler(RedrawScheduler&&) = delete;
+    RedrawScheduler& operator=(RedrawScheduler&&) = delete;
+
+    // Thread-safe; redraws as soon as the frame budget allows
+    void requestRedraw();
+
+    // The caller is about to redraw for user input: pending requests are folded into it
+    void notifyInputRedraw();
+
+    void setMaxFrameRate(unsigned int maxFrameRate); // 0 = uncapped
+    std::chrono::microseconds getFrameInterval() const;
+
+    // Stops the worker; pending requests are discarded
+    void stop();
+
+    // Diagnostics
+    uint64_t getRequestCount() const;
+    uint64_t getRedrawCount() const;
+
+private:
+    RedrawFunction redraw_;
+
+    // Scheduling state (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::chrono::microseconds frameInterval_;
+    std::chrono::steady_clock::time_point lastRedraw_;
+    bool pending_ = false;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> redraws_{0};
+
+    std::thread worker_;
+
+    static std::chrono::microseconds intervalForRate(unsigned int maxFrameRate);
+    void workerLoop();
+};
+
+} // namespace WindowManager
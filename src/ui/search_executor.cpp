@@ -0,0 +1,129 @@
+#include "search_executor.hpp"
+#include <stdexcept>
+
+namespace WindowManager {
+
+SearchExecutor::SearchExecutor(SearchFunction search, ResultCallback onResult,
+                               std::chrono::milliseconds debounceInterval)
+    : search_(std::move(search))
+    , onResult_(std::move(onResult))
+    , debounceInterval_(debounceInterval) {
+
+    if (!search_ || !onResult_) {
+        throw std::invalid_argument("SearchExecutor requires a search function and a result callback");
+    }
+
+    worker_ = std::thread(&SearchExecutor::workerLoop, this);
+}
+
+SearchExecutor::~SearchExecutor() {
+    stop();
+}
+
+uint64_t SearchExecutor::submit(const SearchQuery& query) {
+    return schedule(query, debounceInterval_);
+}
+
+uint64_t SearchExecutor::submitImmediate(const SearchQuery& query) {
+    return schedule(query, std::chrono::milliseconds(0));
+}
+
+uint64_t SearchExecutor::currentGeneration() const {
+    return generation_.load();
+}
+
+bool SearchExecutor::isCurrent(uint64_t generation) const {
+    return generation == generation_.load();
+}
+
+void SearchExecutor::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_ && !worker_.joinable()) {
+            return;
+        }
+        stopping_ = true;
+        pendingQuery_.reset();
+    }
+    condition_.notify_all();
+
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+size_t SearchExecutor::getExecutedSearchCount() const {
+    return executedSearches_.load();
+}
+
+size_t SearchExecutor::getDroppedResultCount() const {
+    return droppedResults_.load();
+}
+
+uint64_t SearchExecutor::schedule(const SearchQuery& query, std::chrono::milliseconds delay) {
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        generation = ++generation_;
+        pendingQuery_ = query;
+        pendingGeneration_ = generation;
+        pendingDeadline_ = std::chrono::steady_clock::now() + delay;
+    }
+    condition_.notify_all();
+    return generation;
+}
+
+void SearchExecutor::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        condition_.wait(lock, [this]() { return stopping_ || pendingQuery_.has_value(); });
+        if (stopping_) {
+            break;
+        }
+
+        // Debounce: every new submission pushes the deadline out again
+        while (!stopping_ && pendingQuery_ &&
+               std::chrono::steady_clock::now() < pendingDeadline_) {
+            condition_.wait_until(lock, pendingDeadline_);
+        }
+        if (stopping_) {
+            break;
+        }
+        if (!pendingQuery_) {
+            continue;
+        }
+
+        SearchQuery query = std::move(*pendingQuery_);
+        uint64_t generation = pendingGeneration_;
+        pendingQuery_.reset();
+
+        lock.unlock();
+
+        // Superseded while waiting for the lock - no point searching
+        if (!isCurrent(generation)) {
+            ++droppedResults_;
+            lock.lock();
+            continue;
+        }
+
+        try {
+            FilterResult result = search_(query);
+            ++executedSearches_;
+
+            // Drop stale results - a newer query has been submitted in the meantime
+            if (isCurrent(generation)) {
+                onResult_(std::move(result), generation);
+            } else {
+                ++droppedResults_;
+            }
+        } catch (const std::exception&) {
+            // Search failures are reported by the search function itself;
+            // the worker keeps serving subsequent queries
+        }
+
+        lock.lock();
+    }
+}
+
+} // namespace WindowManager
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../filters/search_query.hpp"
+#include "../filters/filter_result.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace WindowManager {
+
+/**
+ * Debounced single-worker search executor
+ * Collapses bursts of query changes into one search and tags every query with
+ * a generation so that results superseded by a newer query are dropped
+ */
+class SearchExecutor {
+public:
+    using SearchFunction = std::function<FilterResult(const SearchQuery&)>;
+    using ResultCallback = std::function<void(FilterResult&&, uint64_t)>;
+
+    static constexpr std::chrono::milliseconds DEFAULT_DEBOUNCE_INTERVAL{100};
+
+    SearchExecutor(SearchFunction search, ResultCallback onResult,
+                   std::chrono::milliseconds debounceInterval = DEFAULT_DEBOUNCE_INTERVAL);
+    ~SearchExecutor();
+
+    // Non-copyable, non-moveable (owns the worker thread)
+    SearchExecutor(const SearchExecutor&) = delete;
+    SearchExecutor& operator=(const SearchExecutor&) = delete;
+    SearchExecutor(SearchExecutor&&) = delete;
+    SearchExecutor& operator=(SearchExecutor&&) = delete;
+
+    // Schedule a search; a pending query that has not started yet is replaced.
+    // Returns the generation assigned to the query.
+    uint64_t submit(const SearchQuery& query);
+    uint64_t submitImmediate(const SearchQuery& query); // Skips the debounce delay
+
+    // Generation tracking
+    uint64_t currentGeneration() const;
+    bool isCurrent(uint64_t generation) const;
+
+    // Stops the worker; pending queries are discarded
+    void stop();
+
+    // Diagnostics
+    size_t getExecutedSearchCount() const;
+    size_t getDroppedResultCount() const;
+
+private:
+    SearchFunction search_;
+    ResultCallback onResult_;
+    std::chrono::milliseconds debounceInterval_;
+
+    // Pending request state (guarded by mutex_)
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    std::optional<SearchQuery> pendingQuery_;
+    uint64_t pendingGeneration_ = 0;
+    std::chrono::steady_clock::time_point pendingDeadline_;
+    bool stopping_ = false;
+
+    std::atomic<uint64_t> generation_{0};
+    std::atomic<size_t> executedSearches_{0};
+    std::atomic<size_t> droppedResults_{0};
+
+    std::thread worker_;
+
+    uint64_t schedule(const SearchQuery& query, std::chrono::milliseconds delay);
+    void workerLoop();
+};
+
+} // namespace WindowManager
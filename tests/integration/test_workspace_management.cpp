@@ -245,9 +245,9 @@ TEST_F(WorkspaceManagementTest, CLIIntegration) {
     try {
         // Test workspace summary display
         auto workspaces = windowManager->getAllWorkspaces();
-        auto windows = windowManager->getAllWindows();
+        auto snapshot = windowManager->getSnapshot();
 
-        cli.displayWorkspaceSummary(workspaces, windows);
+        cli.displayWorkspaceSummary(workspaces, *snapshot);
 
         std::string result = output.str();
         EXPECT_FALSE(result.empty());
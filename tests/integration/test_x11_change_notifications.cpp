@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "../../src/platform/linux/x11_enumerator.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include <X11/Xatom.h>
+#include <X11/Xlib.h>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+
+namespace WindowManager {
+namespace Tests {
+
+class X11ChangeNotificationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const char* display = std::getenv("DISPLAY");
+        if (!display || !*display || !(client = XOpenDisplay(nullptr))) {
+            GTEST_SKIP() << "No X display available";
+        }
+    }
+
+    void TearDown() override {
+        if (client) {
+            XCloseDisplay(client);
+        }
+    }
+
+    // Mapped, sized, with a pid but without a title: not listed until it gets one
+    Window createUntitledWindow() {
+        Window window = XCreateSimpleWindow(client, DefaultRootWindow(client), 0, 0, 320, 240, 0, 0, 0);
+        unsigned long pid = static_cast<unsigned long>(getpid());
+        XChangeProperty(client, window, XInternAtom(client, "_NET_WM_PID", False), XA_CARDINAL, 32,
+                        PropModeReplace, reinterpret_cast<unsigned char*>(&pid), 1);
+        XMapWindow(client, window);
+        XSync(client, False);
+        return window;
+    }
+
+    static bool listed(const std::vector<WindowInfo>& windows, const std::string& title) {
+        return std::any_of(windows.begin(), windows.end(),
+                           [&](const WindowInfo& window) { return window.title == title; });
+    }
+
+    Display* client = nullptr;
+};
+
+TEST_F(X11ChangeNotificationTest, WindowTitledAfterMappingIsListed) {
+    X11Enumerator enumerator;
+    enumerator.processChangeNotifications(); // Opens the event connection
+
+    Window window = createUntitledWindow();
+    const std::string title = "late-title-" + std::to_string(getpid());
+    EXPECT_FALSE(listed(enumerator.enumerateWindows(), title));
+
+    // Applies the watch on the rejected window, then drains what the walk queued
+    enumerator.waitForChanges(std::chrono::milliseconds(200));
+    enumerator.enumerateWindows();
+
+    XStoreName(client, window, title.c_str());
+    XSync(client, False);
+
+    bool changed = false;
+    for (int attempt = 0; attempt < 10 && !changed; ++attempt) {
+        changed = enumerator.waitForChanges(std::chrono::milliseconds(200));
+    }
+    EXPECT_TRUE(changed);
+    EXPECT_TRUE(listed(enumerator.enumerateWindows(), title));
+
+    XDestroyWindow(client, window);
+    XSync(client, False);
+}
+
+TEST_F(X11ChangeNotificationTest, WindowLosingItsTitleIsDropped) {
+    X11Enumerator enumerator;
+    enumerator.processChangeNotifications();
+
+    Window window = createUntitledWindow();
+    const std::string title = "lost-title-" + std::to_string(getpid());
+    XStoreName(client, window, title.c_str());
+    XSync(client, False);
+
+    enumerator.waitForChanges(std::chrono::milliseconds(200));
+    EXPECT_TRUE(listed(enumerator.enumerateWindows(), title));
+    enumerator.waitForChanges(std::chrono::milliseconds(200));
+    enumerator.enumerateWindows();
+
+    XStoreName(client, window, "");
+    XSync(client, False);
+
+    bool changed = false;
+    for (int attempt = 0; attempt < 10 && !changed; ++attempt) {
+        changed = enumerator.waitForChanges(std::chrono::milliseconds(200));
+    }
+    EXPECT_TRUE(changed);
+    EXPECT_FALSE(listed(enumerator.enumerateWindows(), title));
+
+    XDestroyWindow(client, window);
+    XSync(client, False);
+}
+
+} // namespace Tests
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
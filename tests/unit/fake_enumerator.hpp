@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../../src/core/enumerator.hpp"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WindowManager {
+namespace Tests {
+
+inline WindowInfo makeWindow(const std::string& handle, const std::string& title, const std::string& owner) {
+    WindowInfo window;
+    window.handle = handle;
+    window.title = title;
+    window.ownerName = owner;
+    window.width = 800;
+    window.height = 600;
+    window.isVisible = true;
+    window.processId = 100;
+    return window;
+}
+
+/**
+ * In-memory WindowEnumerator for tests that need a WindowManager without a display
+ */
+class FakeEnumerator : public WindowEnumerator {
+public:
+    explicit FakeEnumerator(std::vector<WindowInfo> windows = {})
+        : windows_(std::move(windows)) {}
+
+    void setWindows(std::vector<WindowInfo> windows) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        windows_ = std::move(windows);
+    }
+
+    std::vector<WindowInfo> enumerateWindows() override {
+        ++enumerationCount;
+        if (enumerationDelay.count() > 0) {
+            std::this_thread::sleep_for(enumerationDelay);
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        return windows_;
+    }
+
+    bool refreshWindowList() override { return true; }
+
+    std::optional<WindowInfo> getWindowInfo(const std::string& handle) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& window : windows_) {
+            if (window.handle == handle) {
+                return window;
+            }
+        }
+        return std::nullopt;
+    }
+
+    bool focusWindow(const std::string& handle) override {
+        ++focusCount;
+        return getWindowInfo(handle).has_value();
+    }
+
+    bool isWindowValid(const std::string& handle) override {
+        return getWindowInfo(handle).has_value();
+    }
+
+    std::vector<WorkspaceInfo> enumerateWorkspaces() override { return {}; }
+    std::optional<WorkspaceInfo> getCurrentWorkspace() override { return std::nullopt; }
+    std::vector<WindowInfo> enumerateAllWorkspaceWindows() override { return enumerateWindows(); }
+    std::vector<WindowInfo> getWindowsOnWorkspace(const std::string&) override { return {}; }
+    std::optional<WindowInfo> getEnhancedWindowInfo(const std::string& handle) override { return getWindowInfo(handle); }
+    bool isWorkspaceSupported() const override { return false; }
+    std::optional<WindowInfo> getFocusedWindow() override { return std::nullopt; }
+    bool switchToWorkspace(const std::string&) override { return false; }
+    bool canSwitchWorkspaces() const override { return false; }
+
+    std::chrono::milliseconds getLastEnumerationTime() const override { return std::chrono::milliseconds(0); }
+    size_t getWindowCount() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return windows_.size();
+    }
+    std::string getPlatformInfo() const override { return "Fake"; }
+    bool supportsChangeNotifications() const override { return changeNotifications; }
+
+    std::chrono::milliseconds enumerationDelay{0}; // Simulates a slow display server
+    bool changeNotifications = false;              // Reported by supportsChangeNotifications()
+    std::atomic<size_t> enumerationCount{0};
+    std::atomic<size_t> focusCount{0};
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<WindowInfo> windows_;
+};
+
+} // namespace Tests
+} // namespace WindowManager
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "../../src/core/adaptive_ttl.hpp"
+#include "../../src/core/window_manager.hpp"
+#include "fake_enumerator.hpp"
+
+namespace WindowManager {
+namespace Tests {
+
+using std::chrono::milliseconds;
+
+TEST(AdaptiveTtlTest, ShrinksOnChangesAndGrowsWhenIdle) {
+    AdaptiveTtl ttl(milliseconds(500), milliseconds(30000), milliseconds(4000));
+
+    ttl.recordRefresh(true);
+    EXPECT_EQ(ttl.current(), milliseconds(2000));
+    for (int i = 0; i < 10; ++i) {
+        ttl.recordRefresh(true);
+    }
+    EXPECT_EQ(ttl.current(), milliseconds(500));
+    EXPECT_GT(ttl.getChangeRate(), 0.8);
+
+    for (int i = 0; i < 20; ++i) {
+        ttl.recordRefresh(false);
+    }
+    EXPECT_EQ(ttl.current(), milliseconds(30000));
+    EXPECT_LT(ttl.getChangeRate(), 0.1);
+}
+
+TEST(AdaptiveTtlTest, BoundsAreApplied) {
+    AdaptiveTtl ttl(milliseconds(500), milliseconds(30000), milliseconds(60000));
+    EXPECT_EQ(ttl.current(), milliseconds(30000));
+
+    ttl.setBounds(milliseconds(100), milliseconds(1000));
+    EXPECT_EQ(ttl.current(), milliseconds(1000));
+}
+
+TEST(AdaptiveTtlTest, WindowManagerAdaptsWithoutChangeNotifications) {
+    auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{makeWindow("0x1", "Terminal", "xterm")});
+    WindowManager windowManager(std::move(enumerator));
+    ASSERT_TRUE(windowManager.isAdaptiveCacheTtlEnabled());
+
+    // Identical snapshots: the TTL grows
+    windowManager.refreshWindows();
+    auto afterFirst = windowManager.getPerformanceMetrics().effectiveCacheTtl;
+    windowManager.refreshWindows();
+    auto metrics = windowManager.getPerformanceMetrics();
+    EXPECT_TRUE(metrics.adaptiveCacheTtl);
+    EXPECT_GT(metrics.effectiveCacheTtl, afterFirst);
+
+    windowManager.setCacheValidityDuration(milliseconds(1234));
+    EXPECT_FALSE(windowManager.isAdaptiveCacheTtlEnabled());
+    EXPECT_EQ(windowManager.getPerformanceMetrics().effectiveCacheTtl, milliseconds(1234));
+}
+
+TEST(AdaptiveTtlTest, ConsumingChangeNotificationsDisablesTheDefault) {
+    auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{makeWindow("0x1", "Terminal", "xterm")});
+    enumerator->changeNotifications = true;
+    WindowManager windowManager(std::move(enumerator));
+
+    // Nobody drains notifications yet (batch mode, C API): keep adapting
+    EXPECT_TRUE(windowManager.isAdaptiveCacheTtlEnabled());
+
+    windowManager.processChangeNotifications();
+    EXPECT_FALSE(windowManager.isAdaptiveCacheTtlEnabled());
+}
+
+TEST(AdaptiveTtlTest, ExplicitSettingSurvivesChangeNotifications) {
+    auto enumerator = std::make_unique<FakeEnumerator>();
+    enumerator->changeNotifications = true;
+    WindowManager windowManager(std::move(enumerator));
+
+    windowManager.setAdaptiveCacheTtl(true);
+    windowManager.processChangeNotifications();
+    EXPECT_TRUE(windowManager.isAdaptiveCacheTtlEnabled());
+}
+
+} // namespace Tests
+} // namespace WindowManager
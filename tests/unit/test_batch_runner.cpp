@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "../../src/daemon/batch_runner.hpp"
+#include "fake_enumerator.hpp"
+#include <sstream>
+
+namespace WindowManager {
+namespace Tests {
+
+class BatchRunnerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{
+            makeWindow("0x1", "Terminal", "xterm"),
+            makeWindow("0x2", "Firefox", "firefox"),
+        });
+        fake = enumerator.get();
+        windowManager = std::make_unique<WindowManager>(std::move(enumerator));
+    }
+
+    std::vector<std::string> lines(const std::string& text) {
+        std::vector<std::string> result;
+        std::istringstream stream(text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            result.push_back(line);
+        }
+        return result;
+    }
+
+    FakeEnumerator* fake = nullptr;
+    std::unique_ptr<WindowManager> windowManager;
+};
+
+TEST_F(BatchRunnerTest, RespondsInOrderWithOneEnumeration) {
+    std::istringstream input("list\n# comment\nsearch fire\n\n{\"command\":\"focus\",\"handle\":\"0x2\"}\nbogus\n");
+    std::ostringstream output;
+
+    BatchRunner runner(*windowManager, input, output, BatchRunner::FlushMode::PerBatch);
+    EXPECT_EQ(runner.run(), 1u);
+
+    auto responses = lines(output.str());
+    ASSERT_EQ(responses.size(), 4u);
+    EXPECT_NE(responses[0].find(R"("command":"list")"), std::string::npos);
+    EXPECT_NE(responses[1].find(R"("command":"search")"), std::string::npos);
+    EXPECT_NE(responses[2].find(R"("command":"focus")"), std::string::npos);
+    EXPECT_NE(responses[3].find(R"("ok":false)"), std::string::npos);
+
+    EXPECT_EQ(fake->enumerationCount.load(), 1u);
+    EXPECT_EQ(fake->focusCount.load(), 1u);
+}
+
+TEST_F(BatchRunnerTest, MalformedJsonIsReported) {
+    std::istringstream input("{\"command\":\n");
+    std::ostringstream output;
+
+    BatchRunner runner(*windowManager, input, output);
+    EXPECT_EQ(runner.run(), 1u);
+    EXPECT_NE(output.str().find("malformed JSON request"), std::string::npos);
+}
+
+TEST_F(BatchRunnerTest, CrlfLinesAndFailedFocusAreHandled) {
+    std::istringstream input("list\r\n# comment\r\n\r\nfocus 0x9\r\nvalidate 0x9\r\n");
+    std::ostringstream output;
+
+    BatchRunner runner(*windowManager, input, output);
+    EXPECT_EQ(runner.run(), 1u); // Only the focus failed; validating an unknown handle succeeds
+
+    auto responses = lines(output.str());
+    ASSERT_EQ(responses.size(), 3u);
+    EXPECT_NE(responses[0].find(R"("command":"list")"), std::string::npos);
+    EXPECT_NE(responses[1].find(R"("handle":"0x9")"), std::string::npos);
+    EXPECT_NE(responses[2].find(R"("valid":false)"), std::string::npos);
+}
+
+} // namespace Tests
+} // namespace WindowManager
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "../../src/capi/windowmanager_c_internal.hpp"
+#include "fake_enumerator.hpp"
+#include <string>
+
+namespace WindowManager {
+namespace Tests {
+
+class CApiTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{
+            makeWindow("0x1", "Terminal", "xterm"),
+            makeWindow("0x2", "Firefox", "firefox"),
+            makeWindow("0x3", "Firefox Developer", "firefox"),
+        });
+        fake = enumerator.get();
+        context = createCApiContext(std::make_unique<WindowManager>(std::move(enumerator)));
+    }
+
+    void TearDown() override {
+        wm_close(context);
+    }
+
+    FakeEnumerator* fake = nullptr;
+    wm_context* context = nullptr;
+};
+
+TEST_F(CApiTest, SnapshotIteratesAllWindows) {
+    wm_result* result = nullptr;
+    ASSERT_EQ(wm_snapshot(context, &result), WM_OK);
+    ASSERT_EQ(wm_result_count(result), 3u);
+    EXPECT_GT(wm_result_generation(result), 0u);
+
+    wm_window window;
+    ASSERT_EQ(wm_result_get(result, 0, &window), WM_OK);
+    EXPECT_STREQ(window.title, "Firefox");
+    EXPECT_EQ(window.width, 800u);
+    EXPECT_EQ(wm_result_get(result, 3, &window), WM_ERROR_INVALID_ARGUMENT);
+
+    wm_result_free(result);
+}
+
+TEST_F(CApiTest, SearchSharesSnapshot) {
+    wm_result* all = nullptr;
+    wm_result* matches = nullptr;
+    ASSERT_EQ(wm_snapshot(context, &all), WM_OK);
+    ASSERT_EQ(wm_search(context, "firefox", 0, &matches), WM_OK);
+
+    EXPECT_EQ(wm_result_count(matches), 2u);
+    EXPECT_EQ(wm_result_generation(matches), wm_result_generation(all));
+    EXPECT_EQ(fake->enumerationCount.load(), 1u);
+
+    // Results outlive refreshes of the context
+    ASSERT_EQ(wm_refresh(context), WM_OK);
+    wm_window window;
+    ASSERT_EQ(wm_result_get(matches, 1, &window), WM_OK);
+    EXPECT_STREQ(window.owner, "firefox");
+
+    wm_result_free(all);
+    wm_result_free(matches);
+}
+
+TEST_F(CApiTest, FocusReportsStatus) {
+    wm_result* result = nullptr;
+    ASSERT_EQ(wm_snapshot(context, &result), WM_OK);
+    wm_result_free(result);
+
+    EXPECT_EQ(wm_focus(context, "0x2"), WM_OK);
+    EXPECT_EQ(fake->focusCount.load(), 1u);
+
+    EXPECT_EQ(wm_focus(context, nullptr), WM_ERROR_INVALID_ARGUMENT);
+    EXPECT_STREQ(wm_last_error(nullptr), "");
+}
+
+} // namespace Tests
+} // namespace WindowManager
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../../src/core/change_coalescer.hpp"
+
+namespace WindowManager {
+namespace Tests {
+
+using namespace std::chrono_literals;
+
+class ChangeCoalescerTest : public ::testing::Test {
+protected:
+    ChangeCoalescer coalescer{100ms};
+    ChangeCoalescer::Clock::time_point start = ChangeCoalescer::Clock::now();
+};
+
+TEST_F(ChangeCoalescerTest, BurstDeliversFirstAndLastChange) {
+    EXPECT_TRUE(coalescer.submit(1, start));
+    for (int i = 1; i < 10; ++i) {
+        EXPECT_FALSE(coalescer.submit(1, start + i * 5ms));
+    }
+
+    EXPECT_TRUE(coalescer.takeDue(start + 50ms).empty());
+    ASSERT_TRUE(coalescer.nextDeadline().has_value());
+    EXPECT_EQ(*coalescer.nextDeadline(), start + 100ms);
+
+    auto due = coalescer.takeDue(start + 100ms);
+    ASSERT_EQ(due.size(), 1u);
+    EXPECT_EQ(due[0], 1u);
+    EXPECT_FALSE(coalescer.nextDeadline().has_value());
+
+    auto stats = coalescer.getStats();
+    EXPECT_EQ(stats.received, 10u);
+    EXPECT_EQ(stats.delivered, 2u);
+    EXPECT_DOUBLE_EQ(stats.ratio(), 0.8);
+}
+
+TEST_F(ChangeCoalescerTest, KeysAreThrottledIndependently) {
+    EXPECT_TRUE(coalescer.submit(1, start));
+    EXPECT_FALSE(coalescer.submit(1, start + 10ms));
+    EXPECT_TRUE(coalescer.submit(2, start + 10ms));
+
+    // Quiet keys pass straight through once their window has closed
+    EXPECT_TRUE(coalescer.submit(2, start + 200ms));
+    auto due = coalescer.takeDue(start + 200ms);
+    ASSERT_EQ(due.size(), 1u);
+    EXPECT_EQ(due[0], 1u);
+}
+
+TEST_F(ChangeCoalescerTest, ZeroLatencyDisablesCoalescing) {
+    coalescer.setLatency(0ms);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(coalescer.submit(1, start));
+    }
+    EXPECT_FALSE(coalescer.nextDeadline().has_value());
+    EXPECT_DOUBLE_EQ(coalescer.getStats().ratio(), 0.0);
+}
+
+} // namespace Tests
+} // namespace WindowManager
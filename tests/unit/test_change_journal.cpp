@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "../../src/core/change_journal.hpp"
+#include "../../src/core/window_manager.hpp"
+#include "fake_enumerator.hpp"
+
+namespace WindowManager {
+namespace Tests {
+
+TEST(ChangeJournalTest, MergesChangesAcrossGenerations) {
+    auto editor = makeWindow("0x1", "notes.txt", "editor");
+    auto browser = makeWindow("0x2", "Firefox", "firefox");
+    auto terminal = makeWindow("0x3", "bash", "xterm");
+
+    auto renamed = editor;
+    renamed.title = "notes.txt *";
+    auto moved = renamed;
+    moved.x = 400;
+
+    auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{editor, browser});
+    FakeEnumerator* fake = enumerator.get();
+    WindowManager windowManager(std::move(enumerator));
+
+    uint64_t start = windowManager.getChangesSince(0).toGeneration;
+    fake->setWindows({renamed, browser, terminal});
+    windowManager.refreshWindows();
+    fake->setWindows({moved, terminal});
+    windowManager.refreshWindows();
+
+    auto delta = windowManager.getChangesSince(start);
+    EXPECT_FALSE(delta.fullSnapshot);
+    EXPECT_EQ(delta.fromGeneration, start);
+    EXPECT_EQ(delta.toGeneration, start + 2);
+
+    ASSERT_EQ(delta.added.size(), 1u);
+    EXPECT_EQ(delta.added[0].handle, "0x3");
+    ASSERT_EQ(delta.removed.size(), 1u);
+    EXPECT_EQ(delta.removed[0], "0x2");
+    ASSERT_EQ(delta.modified.size(), 1u);
+    EXPECT_EQ(delta.modified[0].window.x, 400);
+    EXPECT_EQ(delta.modified[0].changedFields, WindowFieldTitle | WindowFieldGeometry);
+
+    EXPECT_TRUE(windowManager.getChangesSince(delta.toGeneration).empty());
+}
+
+TEST(ChangeJournalTest, FallsBackToFullSnapshotWhenTruncated) {
+    ChangeJournal journal(2);
+    std::vector<WindowInfo> windows;
+    for (uint64_t generation = 1; generation <= 4; ++generation) {
+        auto previous = windows;
+        windows.push_back(makeWindow("0x" + std::to_string(generation), "window", "app"));
+        journal.record(generation, previous, windows);
+    }
+
+    WindowSnapshot snapshot;
+    snapshot.generation = 4;
+    snapshot.windows = windows;
+
+    EXPECT_EQ(journal.size(), 2u);
+    EXPECT_EQ(journal.oldestGeneration(), 2u);
+
+    auto covered = journal.changesSince(2, snapshot);
+    EXPECT_FALSE(covered.fullSnapshot);
+    EXPECT_EQ(covered.added.size(), 2u);
+
+    auto truncated = journal.changesSince(1, snapshot);
+    EXPECT_TRUE(truncated.fullSnapshot);
+    EXPECT_EQ(truncated.added.size(), 4u);
+
+    // A generation from the future (e.g. a restarted daemon) cannot be patched either
+    EXPECT_TRUE(journal.changesSince(9, snapshot).fullSnapshot);
+}
+
+TEST(ChangeJournalTest, ReAddedHandleIsReportedAsModified) {
+    ChangeJournal journal;
+    auto window = makeWindow("0x1", "a", "app");
+    journal.record(1, {}, {window});
+    journal.record(2, {window}, {});
+    journal.record(3, {}, {window});
+
+    WindowSnapshot snapshot;
+    snapshot.generation = 3;
+    snapshot.windows = {window};
+
+    auto delta = journal.changesSince(1, snapshot);
+    EXPECT_TRUE(delta.added.empty());
+    EXPECT_TRUE(delta.removed.empty());
+    ASSERT_EQ(delta.modified.size(), 1u);
+    EXPECT_EQ(delta.modified[0].changedFields, static_cast<uint32_t>(WindowFieldAll));
+}
+
+} // namespace Tests
+} // namespace WindowManager
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../../src/daemon/event_loop.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include <thread>
+
+namespace WindowManager {
+namespace Tests {
+
+TEST(EventLoopTest, OneShotTimerFiresOnce) {
+    EventLoop loop;
+    int fired = 0;
+
+    loop.addTimer(std::chrono::milliseconds(5), false, [&]() { ++fired; });
+    loop.addTimer(std::chrono::milliseconds(50), false, [&]() { loop.stop(); });
+    loop.run();
+
+    EXPECT_EQ(fired, 1);
+}
+
+TEST(EventLoopTest, RepeatingTimerCanCancelItself) {
+    EventLoop loop;
+    int fired = 0;
+    int timerId = -1;
+
+    timerId = loop.addTimer(std::chrono::milliseconds(2), true, [&]() {
+        if (++fired == 3) {
+            loop.cancelTimer(timerId);
+            loop.stop();
+        }
+    });
+    loop.run();
+
+    EXPECT_EQ(fired, 3);
+}
+
+TEST(EventLoopTest, PostedTasksRunOnLoopThread) {
+    EventLoop loop;
+    std::thread::id taskThread;
+
+    std::thread poster([&]() {
+        loop.post([&]() {
+            taskThread = std::this_thread::get_id();
+            loop.stop();
+        });
+    });
+    loop.run();
+    poster.join();
+
+    EXPECT_EQ(taskThread, std::this_thread::get_id());
+}
+
+} // namespace Tests
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "../../src/platform/linux/multi_display_enumerator.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+namespace WindowManager {
+namespace Tests {
+
+TEST(MultiDisplayHandlesTest, QualifiedIdsRoundTrip) {
+    std::string display;
+    std::string local;
+
+    std::string handle = MultiDisplayEnumerator::qualify(":1", "0x3a00004");
+    EXPECT_EQ(handle, ":1/0x3a00004");
+    ASSERT_TRUE(MultiDisplayEnumerator::splitQualified(handle, display, local));
+    EXPECT_EQ(display, ":1");
+    EXPECT_EQ(local, "0x3a00004");
+
+    // Workspace ids are desktop indices; screen numbers keep their '.'
+    ASSERT_TRUE(MultiDisplayEnumerator::splitQualified(MultiDisplayEnumerator::qualify("host:0.1", "2"),
+                                                       display, local));
+    EXPECT_EQ(display, "host:0.1");
+    EXPECT_EQ(local, "2");
+
+    // Protocol-prefixed display names contain the separator themselves
+    ASSERT_TRUE(MultiDisplayEnumerator::splitQualified(MultiDisplayEnumerator::qualify("tcp/host:0", "0x1"),
+                                                       display, local));
+    EXPECT_EQ(display, "tcp/host:0");
+    EXPECT_EQ(local, "0x1");
+}
+
+TEST(MultiDisplayHandlesTest, UnqualifiedIdsAreLocal) {
+    std::string display = "stale";
+    std::string local;
+
+    EXPECT_FALSE(MultiDisplayEnumerator::splitQualified("0x3a00004", display, local));
+    EXPECT_TRUE(display.empty());
+    EXPECT_EQ(local, "0x3a00004");
+
+    EXPECT_FALSE(MultiDisplayEnumerator::splitQualified("", display, local));
+    EXPECT_TRUE(local.empty());
+}
+
+} // namespace Tests
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
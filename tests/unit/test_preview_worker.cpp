@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "../../src/ui/preview_worker.hpp"
+#include <condition_variable>
+#include <mutex>
+
+namespace WindowManager {
+namespace Tests {
+
+class PreviewWorkerTest : public ::testing::Test {
+protected:
+    std::optional<WindowThumbnail> capture(const std::string& handle, unsigned int maxWidth, unsigned int maxHeight) {
+        if (handle == "unviewable") {
+            return std::nullopt;
+        }
+        WindowThumbnail thumbnail;
+        thumbnail.handle = handle;
+        thumbnail.width = maxWidth;
+        thumbnail.height = maxHeight;
+        thumbnail.pixels.assign(static_cast<size_t>(maxWidth) * maxHeight, 0x336699);
+        thumbnail.capturedAt = std::chrono::steady_clock::now();
+        return thumbnail;
+    }
+
+    void onReady() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++readyCount;
+        ready.notify_all();
+    }
+
+    bool waitForReady(int count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return ready.wait_for(lock, std::chrono::seconds(2), [&]() { return readyCount >= count; });
+    }
+
+    std::unique_ptr<PreviewWorker> createWorker(std::chrono::milliseconds interval) {
+        return std::make_unique<PreviewWorker>(
+            [this](const std::string& handle, unsigned int w, unsigned int h) { return capture(handle, w, h); },
+            [this]() { onReady(); },
+            interval);
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    int readyCount = 0;
+};
+
+TEST_F(PreviewWorkerTest, CapturesRequestedWindowInBackground) {
+    auto worker = createWorker(std::chrono::milliseconds(500));
+
+    EXPECT_EQ(worker->getThumbnail("3a00004"), nullptr);
+    worker->request("3a00004", 8, 4);
+
+    ASSERT_TRUE(waitForReady(1));
+    auto thumbnail = worker->getThumbnail("3a00004");
+    ASSERT_NE(thumbnail, nullptr);
+    EXPECT_EQ(thumbnail->width, 8);
+    EXPECT_EQ(thumbnail->height, 4);
+    EXPECT_EQ(thumbnail->pixelAt(7, 3), 0x336699u);
+}
+
+TEST_F(PreviewWorkerTest, CapturesAreRateLimited) {
+    auto worker = createWorker(std::chrono::seconds(10));
+
+    for (int i = 0; i < 50; ++i) {
+        worker->request("3a00004", 8, 4);
+    }
+    ASSERT_TRUE(waitForReady(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    EXPECT_EQ(worker->getCaptureCount(), 1);
+}
+
+TEST_F(PreviewWorkerTest, FailedCaptureLeavesNoThumbnail) {
+    auto worker = createWorker(std::chrono::seconds(10));
+
+    worker->request("unviewable", 8, 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    worker->stop();
+
+    EXPECT_EQ(worker->getCaptureCount(), 1);
+    EXPECT_EQ(worker->getThumbnail("unviewable"), nullptr);
+    EXPECT_EQ(readyCount, 0);
+}
+
+} // namespace Tests
+} // namespace WindowManager
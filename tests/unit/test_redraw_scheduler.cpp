@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "../../src/ui/redraw_scheduler.hpp"
+#include <condition_variable>
+#include <mutex>
+
+namespace WindowManager {
+namespace Tests {
+
+class RedrawSchedulerTest : public ::testing::Test {
+protected:
+    void onRedraw() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++redrawCount;
+        redrawn.notify_all();
+    }
+
+    bool waitForRedraws(int count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return redrawn.wait_for(lock, std::chrono::seconds(2), [&]() { return redrawCount >= count; });
+    }
+
+    std::unique_ptr<RedrawScheduler> createScheduler(unsigned int maxFrameRate) {
+        return std::make_unique<RedrawScheduler>([this]() { onRedraw(); }, maxFrameRate);
+    }
+
+    std::mutex mutex;
+    std::condition_variable redrawn;
+    int redrawCount = 0;
+};
+
+TEST_F(RedrawSchedulerTest, SingleRequestRedraws) {
+    auto scheduler = createScheduler(60);
+
+    scheduler->requestRedraw();
+
+    ASSERT_TRUE(waitForRedraws(1));
+    EXPECT_EQ(scheduler->getRedrawCount(), 1);
+}
+
+TEST_F(RedrawSchedulerTest, BurstIsCoalescedByFrameRate) {
+    // 5 fps: a 100-request burst fits in two frames at most
+    auto scheduler = createScheduler(5);
+
+    for (int i = 0; i < 100; ++i) {
+        scheduler->requestRedraw();
+    }
+
+    ASSERT_TRUE(waitForRedraws(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    scheduler->stop();
+
+    EXPECT_EQ(scheduler->getRequestCount(), 100);
+    EXPECT_GE(scheduler->getRedrawCount(), 1);
+    EXPECT_LE(scheduler->getRedrawCount(), 2);
+}
+
+TEST_F(RedrawSchedulerTest, InputRedrawAbsorbsPendingRequest) {
+    auto scheduler = createScheduler(1);
+
+    // Use up the frame budget, then queue a request that must wait a full second
+    scheduler->requestRedraw();
+    ASSERT_TRUE(waitForRedraws(1));
+    scheduler->requestRedraw();
+    scheduler->notifyInputRedraw();
+
+    scheduler->stop();
+    EXPECT_EQ(scheduler->getRedrawCount(), 1);
+}
+
+TEST_F(RedrawSchedulerTest, FrameRateIsConfigurable) {
+    auto scheduler = createScheduler(60);
+    EXPECT_EQ(scheduler->getFrameInterval(), std::chrono::microseconds(16666));
+
+    scheduler->setMaxFrameRate(0);
+    EXPECT_EQ(scheduler->getFrameInterval(), std::chrono::microseconds(0));
+}
+
+} // namespace Tests
+} // namespace WindowManager
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../../src/daemon/request_handler.hpp"
+#include "fake_enumerator.hpp"
+#include <vector>
+
+namespace WindowManager {
+namespace Tests {
+
+class RequestHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{
+            makeWindow("0x1", "Terminal \"main\"", "xterm"),
+            makeWindow("0x2", "Firefox", "firefox"),
+        });
+        fake = enumerator.get();
+        windowManager = std::make_unique<WindowManager>(std::move(enumerator));
+
+        // Inline executor: X tasks run immediately on the calling thread
+        handler = std::make_unique<RequestHandler>(
+            *windowManager,
+            [this]() { return windowManager->getSnapshot(); },
+            [this](RequestHandler::XTask task, RequestHandler::Reply reply) {
+                ++executedTasks;
+                reply(task());
+            });
+    }
+
+    std::string request(const std::string& line) {
+        std::vector<std::string> replies;
+        handler->handle(line, [&](RequestHandler::Response response) {
+            EXPECT_EQ(response.ok, response.line.compare(0, 10, R"({"ok":true)") == 0) << line;
+            replies.push_back(std::move(response.line));
+        });
+        EXPECT_EQ(replies.size(), 1u) << line;
+        return replies.empty() ? "" : replies.front();
+    }
+
+    FakeEnumerator* fake = nullptr;
+    std::unique_ptr<WindowManager> windowManager;
+    std::unique_ptr<RequestHandler> handler;
+    int executedTasks = 0;
+};
+
+TEST_F(RequestHandlerTest, QueriesAreServedFromSnapshot) {
+    std::string list = request("list");
+    EXPECT_NE(list.find(R"("ok":true)"), std::string::npos);
+    EXPECT_NE(list.find(R"("count":2)"), std::string::npos);
+    EXPECT_NE(list.find(R"(Terminal \"main\")"), std::string::npos);
+
+    std::string search = request("search fire");
+    EXPECT_NE(search.find(R"("count":1)"), std::string::npos);
+    EXPECT_NE(search.find(R"("handle":"0x2")"), std::string::npos);
+
+    EXPECT_EQ(executedTasks, 0);
+    EXPECT_EQ(fake->enumerationCount.load(), 1u);
+}
+
+TEST_F(RequestHandlerTest, FocusRunsOnXExecutor) {
+    std::string response = request("focus 0x2");
+
+    EXPECT_EQ(executedTasks, 1);
+    EXPECT_EQ(fake->focusCount.load(), 1u);
+    EXPECT_NE(response.find(R"("ok":true)"), std::string::npos);
+}
+
+TEST_F(RequestHandlerTest, ChangesReportsDeltaSinceGeneration) {
+    std::string full = request("changes 0");
+    EXPECT_NE(full.find(R"("full":true)"), std::string::npos);
+    EXPECT_NE(full.find(R"("generation":1)"), std::string::npos);
+
+    auto renamed = makeWindow("0x2", "Firefox - News", "firefox");
+    fake->setWindows({makeWindow("0x1", "Terminal \"main\"", "xterm"), renamed});
+    windowManager->refreshWindows();
+
+    std::string delta = request(R"({"command":"changes","since":"1"})");
+    EXPECT_NE(delta.find(R"("full":false)"), std::string::npos);
+    EXPECT_NE(delta.find(R"("removed":[])"), std::string::npos);
+    EXPECT_NE(delta.find(R"({"fields":["title"],"window":{"handle":"0x2")"), std::string::npos);
+    EXPECT_EQ(executedTasks, 0);
+
+    EXPECT_NE(request("changes soon").find(R"("ok":false)"), std::string::npos);
+}
+
+TEST_F(RequestHandlerTest, IfChangedSkipsUnchangedResults) {
+    auto etagOf = [](const std::string& response) {
+        auto start = response.find(R"("etag":")") + 8;
+        return response.substr(start, response.find('"', start) - start);
+    };
+
+    std::string etag = etagOf(request("list"));
+    ASSERT_EQ(etag.size(), 16u);
+
+    // A refresh that finds the same windows bumps the generation but keeps the etag
+    windowManager->refreshWindows();
+    std::string unchanged = request("list --if-changed " + etag);
+    EXPECT_NE(unchanged.find(R"("notModified":true)"), std::string::npos);
+    EXPECT_NE(unchanged.find(R"("generation":2)"), std::string::npos);
+    EXPECT_EQ(unchanged.find(R"("windows")"), std::string::npos);
+
+    std::string searchEtag = etagOf(request("search fire"));
+    fake->setWindows({makeWindow("0x1", "Terminal", "xterm"), makeWindow("0x2", "Firefox", "firefox")});
+    windowManager->refreshWindows();
+
+    EXPECT_NE(request("list --if-changed " + etag).find(R"("count":2)"), std::string::npos);
+    std::string search = request(R"({"command":"search","query":"fire","ifChanged":")" + searchEtag + "\"}");
+    EXPECT_NE(search.find(R"("notModified":true)"), std::string::npos);
+}
+
+TEST_F(RequestHandlerTest, ErrorsAreSingleLineJson) {
+    std::string unknown = request("frobnicate");
+    EXPECT_NE(unknown.find(R"("ok":false)"), std::string::npos);
+    EXPECT_EQ(unknown.find('\n'), std::string::npos);
+
+    std::string missing = request("focus");
+    EXPECT_NE(missing.find(R"("ok":false)"), std::string::npos);
+    EXPECT_EQ(executedTasks, 0);
+}
+
+} // namespace Tests
+} // namespace WindowManager
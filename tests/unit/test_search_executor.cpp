@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../../src/ui/search_executor.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace WindowManager {
+namespace Tests {
+
+class SearchExecutorTest : public ::testing::Test {
+protected:
+    FilterResult search(const SearchQuery& query) {
+        std::lock_guard<std::mutex> lock(mutex);
+        searchedQueries.push_back(query.query);
+        return FilterResult({}, 0, query, std::chrono::milliseconds(0));
+    }
+
+    void onResult(FilterResult&& result, uint64_t generation) {
+        std::lock_guard<std::mutex> lock(mutex);
+        deliveredQueries.push_back(result.query.query);
+        deliveredGenerations.push_back(generation);
+        resultDelivered.notify_all();
+    }
+
+    bool waitForResults(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return resultDelivered.wait_for(lock, std::chrono::seconds(2),
+                                        [&]() { return deliveredQueries.size() >= count; });
+    }
+
+    std::unique_ptr<SearchExecutor> createExecutor(std::chrono::milliseconds debounce) {
+        return std::make_unique<SearchExecutor>(
+            [this](const SearchQuery& query) { return search(query); },
+            [this](FilterResult&& result, uint64_t generation) { onResult(std::move(result), generation); },
+            debounce);
+    }
+
+    std::mutex mutex;
+    std::condition_variable resultDelivered;
+    std::vector<std::string> searchedQueries;
+    std::vector<std::string> deliveredQueries;
+    std::vector<uint64_t> deliveredGenerations;
+};
+
+TEST_F(SearchExecutorTest, TypingBurstRunsSingleSearch) {
+    auto executor = createExecutor(std::chrono::milliseconds(50));
+
+    uint64_t lastGeneration = 0;
+    for (const char* prefix : {"c", "ch", "chr", "chro", "chrom", "chrome"}) {
+        lastGeneration = executor->submit(SearchQuery(prefix));
+    }
+
+    ASSERT_TRUE(waitForResults(1));
+    executor->stop();
+
+    EXPECT_EQ(searchedQueries.size(), 1);
+    ASSERT_EQ(deliveredQueries.size(), 1);
+    EXPECT_EQ(deliveredQueries[0], "chrome");
+    EXPECT_EQ(deliveredGenerations[0], lastGeneration);
+}
+
+TEST_F(SearchExecutorTest, ImmediateSubmissionSkipsDebounce) {
+    auto executor = createExecutor(std::chrono::seconds(10));
+
+    auto start = std::chrono::steady_clock::now();
+    executor->submitImmediate(SearchQuery("terminal"));
+
+    ASSERT_TRUE(waitForResults(1));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+    EXPECT_EQ(deliveredQueries[0], "terminal");
+}
+
+TEST_F(SearchExecutorTest, GenerationsIncreaseMonotonically) {
+    auto executor = createExecutor(std::chrono::milliseconds(0));
+
+    uint64_t first = executor->submitImmediate(SearchQuery("a"));
+    uint64_t second = executor->submitImmediate(SearchQuery("b"));
+
+    EXPECT_LT(first, second);
+    EXPECT_FALSE(executor->isCurrent(first));
+    EXPECT_TRUE(executor->isCurrent(second));
+    EXPECT_EQ(executor->currentGeneration(), second);
+}
+
+TEST_F(SearchExecutorTest, StopDiscardsPendingQuery) {
+    auto executor = createExecutor(std::chrono::seconds(10));
+
+    executor->submit(SearchQuery("pending"));
+    executor->stop();
+
+    EXPECT_TRUE(searchedQueries.empty());
+    EXPECT_TRUE(deliveredQueries.empty());
+}
+
+} // namespace Tests
+} // namespace WindowManager
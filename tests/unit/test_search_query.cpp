@@ -190,6 +190,39 @@ TEST_F(SearchQueryTest, ToStringOutput) {
     EXPECT_NE(str.find("workspace_1"), std::string::npos);
 }
 
+TEST_F(SearchQueryTest, MatchSpans) {
+    SearchQuery query("chrome");
+
+    auto spans = query.findMatchSpans("Chrome - Google CHROME", SearchField::Title);
+    ASSERT_EQ(spans.size(), 2);
+    EXPECT_EQ(spans[0].offset, 0);
+    EXPECT_EQ(spans[0].length, 6);
+    EXPECT_EQ(spans[1].offset, 16);
+    EXPECT_EQ(spans[1].length, 6);
+
+    SearchQuery caseQuery("Chrome", SearchField::Both, true);
+    EXPECT_EQ(caseQuery.findMatchSpans("chrome Chrome", SearchField::Owner).size(), 1);
+
+    SearchQuery regexQuery("[0-9]+", SearchField::Title, false, true);
+    auto regexSpans = regexQuery.findMatchSpans("tab 12 of 345", SearchField::Title);
+    ASSERT_EQ(regexSpans.size(), 2);
+    EXPECT_EQ(regexSpans[1].offset, 10);
+    EXPECT_EQ(regexSpans[1].length, 3);
+
+    EXPECT_TRUE(SearchQuery("").findMatchSpans("anything", SearchField::Title).empty());
+}
+
+TEST_F(SearchQueryTest, MatchSpansOnlyCoverSearchedFields) {
+    // matches() never counts the owner for a title query, so nothing there is highlighted
+    SearchQuery titleQuery("term", SearchField::Title);
+    EXPECT_EQ(titleQuery.findMatchSpans("Terminal", SearchField::Title).size(), 1);
+    EXPECT_TRUE(titleQuery.findMatchSpans("gnome-terminal", SearchField::Owner).empty());
+
+    SearchQuery ownerQuery("term", SearchField::Owner);
+    EXPECT_TRUE(ownerQuery.findMatchSpans("Terminal", SearchField::Title).empty());
+    EXPECT_EQ(ownerQuery.findMatchSpans("gnome-terminal", SearchField::Owner).size(), 1);
+}
+
 TEST_F(SearchQueryTest, ComplexSearchScenarios) {
     // Test realistic search scenarios
 
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../../src/daemon/shared_snapshot.hpp"
+
+#ifdef WM_PLATFORM_LINUX
+
+#include "../../src/core/exceptions.hpp"
+#include "fake_enumerator.hpp"
+#include <atomic>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+namespace WindowManager {
+namespace Tests {
+
+class SharedSnapshotTest : public ::testing::Test {
+protected:
+    std::string name = "/window-manager-test-" + std::to_string(getpid());
+
+    WindowSnapshot makeSnapshot(uint64_t generation, size_t windowCount) {
+        WindowSnapshot snapshot;
+        snapshot.generation = generation;
+        snapshot.capturedAt = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < windowCount; ++i) {
+            auto window = makeWindow("0x" + std::to_string(i), "Window " + std::to_string(generation), "app");
+            window.workspaceId = "1";
+            window.isFocused = (i == 0);
+            snapshot.windows.push_back(window);
+        }
+        return snapshot;
+    }
+};
+
+TEST_F(SharedSnapshotTest, ReaderSeesPublishedSnapshot) {
+    SnapshotPublisher publisher(name);
+    publisher.publish(makeSnapshot(7, 3));
+
+    SnapshotReader reader(name);
+    EXPECT_EQ(reader.getGeneration(), std::optional<uint64_t>(7u));
+
+    auto snapshot = reader.read();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_EQ(snapshot->generation, 7u);
+    ASSERT_EQ(snapshot->windows.size(), 3u);
+    EXPECT_EQ(snapshot->windows[1].handle, "0x1");
+    EXPECT_EQ(snapshot->windows[1].title, "Window 7");
+    EXPECT_EQ(snapshot->windows[1].workspaceId, "1");
+    EXPECT_TRUE(snapshot->windows[0].isFocused);
+    EXPECT_FALSE(snapshot->windows[1].isFocused);
+    EXPECT_EQ(snapshot->windows[2].width, 800u);
+}
+
+TEST_F(SharedSnapshotTest, SnapshotsLargerThanCapacityAreCut) {
+    SnapshotPublisher publisher(name, 256);
+    publisher.publish(makeSnapshot(1, 100));
+
+    SnapshotReader reader(name);
+    auto snapshot = reader.read();
+    ASSERT_TRUE(snapshot.has_value());
+    EXPECT_GT(snapshot->windows.size(), 0u);
+    EXPECT_LT(snapshot->windows.size(), 100u);
+}
+
+TEST_F(SharedSnapshotTest, ConcurrentReadsAreNeverTorn) {
+    SnapshotPublisher publisher(name);
+    publisher.publish(makeSnapshot(1, 20));
+    SnapshotReader reader(name);
+
+    std::atomic<bool> done{false};
+    std::thread writer([&]() {
+        for (uint64_t generation = 2; generation < 2000; ++generation) {
+            publisher.publish(makeSnapshot(generation, 20));
+        }
+        done = true;
+    });
+
+    size_t consistentReads = 0;
+    while (!done) {
+        auto snapshot = reader.read();
+        if (!snapshot) {
+            continue;
+        }
+        ASSERT_EQ(snapshot->windows.size(), 20u);
+        std::string expectedTitle = "Window " + std::to_string(snapshot->generation);
+        for (const auto& window : snapshot->windows) {
+            ASSERT_EQ(window.title, expectedTitle);
+        }
+        ++consistentReads;
+    }
+    writer.join();
+
+    EXPECT_GT(consistentReads, 0u);
+}
+
+TEST_F(SharedSnapshotTest, WriterDyingMidPublishDoesNotHangReaders) {
+    SnapshotPublisher publisher(name);
+    publisher.publish(makeSnapshot(3, 2));
+    SnapshotReader reader(name);
+
+    // Leave the sequence odd, as a daemon killed inside publish() would
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    ASSERT_GE(fd, 0);
+    void* mapping = mmap(nullptr, sizeof(SharedSnapshotHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    ASSERT_NE(mapping, MAP_FAILED);
+    static_cast<SharedSnapshotHeader*>(mapping)->sequence.fetch_add(1);
+
+    EXPECT_FALSE(reader.getGeneration().has_value());
+    EXPECT_FALSE(reader.read().has_value());
+    munmap(mapping, sizeof(SharedSnapshotHeader));
+}
+
+TEST_F(SharedSnapshotTest, MissingSegmentThrows) {
+    EXPECT_THROW({ SnapshotReader reader("/window-manager-test-missing"); }, PlatformApiException);
+}
+
+} // namespace Tests
+} // namespace WindowManager
+
+#endif // WM_PLATFORM_LINUX
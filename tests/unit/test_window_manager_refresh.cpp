@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "../../src/core/window_manager.hpp"
+#include "fake_enumerator.hpp"
+#include <thread>
+#include <vector>
+
+namespace WindowManager {
+namespace Tests {
+
+class WindowManagerRefreshTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{
+            makeWindow("0x1", "Terminal", "xterm"),
+            makeWindow("0x2", "Firefox", "firefox"),
+        });
+        fake = enumerator.get();
+        windowManager = std::make_unique<WindowManager>(std::move(enumerator));
+    }
+
+    FakeEnumerator* fake = nullptr;
+    std::unique_ptr<WindowManager> windowManager;
+};
+
+TEST_F(WindowManagerRefreshTest, ConcurrentRefreshesShareOneEnumeration) {
+    fake->enumerationDelay = std::chrono::milliseconds(200);
+
+    constexpr size_t CALLERS = 8;
+    std::vector<size_t> windowCounts(CALLERS, 0);
+    std::vector<std::thread> callers;
+    for (size_t i = 0; i < CALLERS; ++i) {
+        callers.emplace_back([this, i, &windowCounts]() {
+            windowCounts[i] = windowManager->getAllWindows().size();
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ(fake->enumerationCount.load(), 1u);
+    for (size_t count : windowCounts) {
+        EXPECT_EQ(count, 2u);
+    }
+
+    auto metrics = windowManager->getPerformanceMetrics();
+    EXPECT_EQ(metrics.windowEnumerationCount, 1u);
+    EXPECT_EQ(metrics.coalescedRefreshCount, CALLERS - 1);
+}
+
+TEST_F(WindowManagerRefreshTest, SequentialRefreshesEnumerateEachTime) {
+    EXPECT_TRUE(windowManager->refreshWindows());
+    EXPECT_TRUE(windowManager->refreshWindows());
+
+    EXPECT_EQ(fake->enumerationCount.load(), 2u);
+    EXPECT_EQ(windowManager->getPerformanceMetrics().coalescedRefreshCount, 0u);
+}
+
+TEST_F(WindowManagerRefreshTest, StaleSnapshotIsServedWhileRevalidating) {
+    windowManager->setStaleWhileRevalidate(true, std::chrono::milliseconds(60000));
+    windowManager->setCacheValidityDuration(std::chrono::milliseconds(20));
+    auto first = windowManager->getSnapshot();
+    ASSERT_TRUE(first);
+
+    // Expire the cache by age without invalidating it
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    fake->enumerationDelay = std::chrono::milliseconds(300);
+
+    auto start = std::chrono::steady_clock::now();
+    auto served = windowManager->getSnapshot();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    EXPECT_EQ(served->generation, first->generation);
+
+    // The background refresh publishes a newer snapshot
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_GT(windowManager->getLatestSnapshot()->generation, first->generation);
+    EXPECT_EQ(fake->enumerationCount.load(), 2u);
+}
+
+TEST_F(WindowManagerRefreshTest, CallersArrivingMidRevalidationAreNotBlocked) {
+    windowManager->setStaleWhileRevalidate(true, std::chrono::milliseconds(60000));
+    windowManager->setCacheValidityDuration(std::chrono::milliseconds(20));
+    auto first = windowManager->getSnapshot();
+    ASSERT_TRUE(first);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    fake->enumerationDelay = std::chrono::milliseconds(500);
+
+    // The first stale read starts the background refresh; wait until it is inside the enumerator
+    windowManager->getSnapshot();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(fake->enumerationCount.load(), 2u);
+
+    auto start = std::chrono::steady_clock::now();
+    auto served = windowManager->getSnapshot();
+    auto windows = windowManager->getAllWindows();
+    auto age = windowManager->getCacheAge();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+
+    EXPECT_EQ(served->generation, first->generation);
+    EXPECT_EQ(windows.size(), 2u);
+    EXPECT_GE(age, std::chrono::milliseconds(150));
+    EXPECT_EQ(fake->enumerationCount.load(), 2u);
+}
+
+TEST_F(WindowManagerRefreshTest, InvalidatedCacheRefreshesSynchronously) {
+    windowManager->setStaleWhileRevalidate(true);
+    auto first = windowManager->getSnapshot();
+
+    windowManager->invalidateCache();
+    auto next = windowManager->getSnapshot();
+
+    EXPECT_GT(next->generation, first->generation);
+    EXPECT_EQ(fake->enumerationCount.load(), 2u);
+}
+
+TEST_F(WindowManagerRefreshTest, InvalidationDuringEnumerationIsKept) {
+    fake->enumerationDelay = std::chrono::milliseconds(200);
+    std::thread reader([this]() { windowManager->getSnapshot(); });
+
+    // A change event arriving while that pass is inside the enumerator
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    windowManager->invalidateCache();
+    reader.join();
+
+    fake->enumerationDelay = std::chrono::milliseconds(0);
+    windowManager->getSnapshot();
+    EXPECT_EQ(fake->enumerationCount.load(), 2u);
+}
+
+TEST_F(WindowManagerRefreshTest, ForcedRefreshDoesNotJoinAnOlderPass) {
+    fake->enumerationDelay = std::chrono::milliseconds(200);
+    std::thread reader([this]() { windowManager->getSnapshot(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // The window set changes after the reader's pass captured it
+    fake->setWindows({makeWindow("0x3", "Editor", "vim")});
+    EXPECT_TRUE(windowManager->refreshWindows());
+    reader.join();
+
+    EXPECT_EQ(fake->enumerationCount.load(), 2u);
+    auto windows = windowManager->getLatestSnapshot()->windows;
+    ASSERT_EQ(windows.size(), 1u);
+    EXPECT_EQ(windows.front().handle, "0x3");
+}
+
+TEST_F(WindowManagerRefreshTest, InterruptEndsWaitForChangesEarly) {
+    auto start = std::chrono::steady_clock::now();
+    std::thread waiter([this]() {
+        EXPECT_FALSE(windowManager->waitForChanges(std::chrono::seconds(5)));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    windowManager->interruptWaitForChanges();
+    waiter.join();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    // An interrupt that arrives first ends the next wait immediately
+    windowManager->interruptWaitForChanges();
+    EXPECT_FALSE(windowManager->waitForChanges(std::chrono::seconds(5)));
+}
+
+} // namespace Tests
+} // namespace WindowManager
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "../../src/core/workspace_index.hpp"
+#include "../../src/core/window_manager.hpp"
+#include "../../src/filters/filter_result.hpp"
+#include "fake_enumerator.hpp"
+
+namespace WindowManager {
+namespace Tests {
+
+namespace {
+
+WindowInfo makeWindowOn(const std::string& handle, const std::string& workspaceId) {
+    auto window = makeWindow(handle, "window " + handle, "app");
+    window.workspaceId = workspaceId;
+    return window;
+}
+
+} // namespace
+
+TEST(WorkspaceIndexTest, MovesOnlyChangedWindowsBetweenBuckets) {
+    WorkspaceIndex index;
+    auto first = index.update({makeWindowOn("0x1", "0"), makeWindowOn("0x2", "0"), makeWindowOn("0x3", "1"),
+                               makeWindowOn("0x4", "2")});
+    ASSERT_TRUE(first);
+    EXPECT_EQ(first->countOn("0"), 2u);
+    EXPECT_EQ(first->totalWindows(), 4u);
+
+    // 0x2 moves to desktop 1; desktop 2 is untouched and keeps its bucket
+    auto second = index.update({makeWindowOn("0x1", "0"), makeWindowOn("0x2", "1"), makeWindowOn("0x3", "1"),
+                                makeWindowOn("0x4", "2")});
+    EXPECT_NE(second, first);
+    EXPECT_EQ(second->windowsOn("0"), std::vector<std::string>({"0x1"}));
+    EXPECT_EQ(second->windowsOn("1"), std::vector<std::string>({"0x2", "0x3"}));
+    EXPECT_EQ(second->handles.at("2"), first->handles.at("2"));
+
+    // Unchanged membership republishes the same buckets
+    auto third = index.update({makeWindowOn("0x3", "1"), makeWindowOn("0x1", "0"), makeWindowOn("0x2", "1"),
+                               makeWindowOn("0x4", "2")});
+    EXPECT_EQ(third, second);
+}
+
+TEST(WorkspaceIndexTest, DropsClosedWindowsAndEmptyWorkspaces) {
+    WorkspaceIndex index;
+    index.update({makeWindowOn("0x1", "0"), makeWindowOn("0x2", "1")});
+
+    auto buckets = index.update({makeWindowOn("0x1", "0")});
+    EXPECT_EQ(buckets->handles.count("1"), 0u);
+    EXPECT_TRUE(buckets->windowsOn("1").empty());
+    EXPECT_EQ(buckets->totalWindows(), 1u);
+}
+
+TEST(WorkspaceIndexTest, WindowManagerStatisticsComeWithTheSnapshot) {
+    auto focused = makeWindowOn("0x1", "0");
+    focused.isFocused = true;
+    auto minimized = makeWindowOn("0x2", "1");
+    minimized.isMinimized = true;
+    minimized.isVisible = false;
+
+    auto enumerator = std::make_unique<FakeEnumerator>(std::vector<WindowInfo>{focused, minimized});
+    FakeEnumerator* fake = enumerator.get();
+    WindowManager windowManager(std::move(enumerator));
+
+    auto stats = windowManager.getWorkspaceStatistics();
+    EXPECT_EQ(stats.totalWindows, 2u);
+    EXPECT_EQ(stats.visibleWindows, 1u);
+    EXPECT_EQ(stats.hiddenWindows, 1u);
+    EXPECT_EQ(stats.minimizedWindows, 1u);
+    EXPECT_EQ(stats.focusedWindows, 1u);
+
+    // Served from the cached snapshot, without enumerating again
+    size_t enumerations = fake->enumerationCount;
+    windowManager.getWorkspaceStatistics();
+    EXPECT_EQ(fake->enumerationCount, enumerations);
+}
+
+} // namespace Tests
+} // namespace WindowManager